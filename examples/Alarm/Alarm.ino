@@ -0,0 +1,87 @@
+/***************************************************************
+ * @file    Alarm.ino
+ * @brief   Example of declarative CO₂ / T / RH alarm rules with
+ *          hysteresis and debounce (SCD4x_Alarm_7Semi).
+ *
+ * Features demonstrated:
+ *  - Rule table: channel, comparator, threshold, hysteresis, hold
+ *  - Enter / exit events via callback
+ *  - Low-power periodic (30 s) while clear, standard periodic (5 s)
+ *    while any alarm is active
+ *  - No sensor reads while the mode switch is in progress
+ *
+ * Rules used:
+ * - CO₂ > 1000 ppm for 3 samples, clears below 900 ppm
+ * - T   > 30.00 °C for 2 samples, clears below 29.50 °C
+ * - RH  < 20.00 % for 2 samples, clears above 22.00 %
+ *
+ * Connections:
+ * - SDA -> Default board SDA
+ * - SCL -> Default board SCL
+ * - VIN -> 3.3V / 5V (depending on module)
+ * - GND -> GND
+ *
+ * @author   7Semi
+ * @license  MIT
+ * @version  1.0
+ ***************************************************************/
+
+#include <7Semi_SCD4x.h>
+#include <7Semi_SCD4x_Alarm.h>
+
+SCD4x_7Semi scd;
+
+SCD4x_AlarmRule_7Semi rules[] = {
+  { SCD4x_Alarm_7Semi::CO2,         SCD4x_Alarm_7Semi::ABOVE, 1000, 100, 3 },
+  { SCD4x_Alarm_7Semi::TEMPERATURE, SCD4x_Alarm_7Semi::ABOVE, 3000,  50, 2 },
+  { SCD4x_Alarm_7Semi::HUMIDITY,    SCD4x_Alarm_7Semi::BELOW, 2000, 200, 2 },
+};
+
+void onAlarm(uint8_t rule, bool entered, int32_t value) {
+  Serial.print(entered ? F("ALARM  rule ") : F("CLEAR  rule "));
+  Serial.print(rule);
+  Serial.print(F("  value "));
+  Serial.println(value);
+}
+
+SCD4x_Alarm_7Semi alarms(rules, sizeof(rules) / sizeof(rules[0]), onAlarm);
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    ;
+
+  Serial.println(F("7Semi SCD4x\n Alarm rules"));
+
+  while (!scd.begin()) {
+    Serial.println(F("Sensor not detected."));
+    delay(1000);
+  }
+
+  if (!scd.startLowPowerPeriodicMeasurement()) {
+    Serial.println(F("startLowPowerPeriodicMeasurement failed"));
+    while (1) delay(1000);
+  }
+  alarms.attachSensor(&scd, true);  // restored to low-power when clear
+}
+
+void loop() {
+  static uint32_t t = 0;
+  alarms.poll();  // finishes a pending mode switch without blocking
+  if (alarms.switching()) return;  // sensor takes no commands while stopping
+  if (millis() - t < 1000) return;  // poll data-ready every ~1 s
+  t = millis();
+
+  uint16_t st = 0;
+  if (scd.getDataReadyStatus(st) && (st & 0x07FF)) {
+    uint16_t co2;
+    float tc, rh;
+    if (scd.readMeasurement(co2, tc, rh)) {
+      uint8_t n = alarms.update(co2, tc, rh);
+      Serial.print(F("CO2 "));
+      Serial.print(co2);
+      Serial.print(F(" ppm  active alarms "));
+      Serial.println(n);
+    }
+  }
+}
@@ -0,0 +1,127 @@
+/***************************************************************
+ * @file    CommandQueue.ino
+ * @brief   Example of a per-sensor command queue that fits
+ *          maintenance traffic around the periodic sample reads
+ *          (SCD4x_Queue_7Semi).
+ *
+ * Features demonstrated:
+ *  - Samples delivered by callback, read within the guard window
+ *  - Ambient pressure updates (allowed while measuring) every 10 s,
+ *    run only where they cannot delay the next sample
+ *  - ASC / variant getters batched into one stop → ops → restart
+ *    bracket right after a sample (every 10 min: each bracket costs
+ *    one sample period)
+ *  - Compare-before-write: the temperature offset is read once and only
+ *    written, then persisted, if it differs from the wanted value
+ *  - Queue depth, deferrals, deadline misses and sample lag
+ *
+ * Notes:
+ * - persistSettings() writes the sensor's EEPROM (≈2000 cycles). Queue
+ *   it only after a setter changed something, never on a timer.
+ *
+ * Connections:
+ * - SDA -> Default board SDA
+ * - SCL -> Default board SCL
+ * - VIN -> 3.3V / 5V (depending on module)
+ * - GND -> GND
+ *
+ * @author   7Semi
+ * @license  MIT
+ * @version  1.0
+ ***************************************************************/
+
+#include <7Semi_SCD4x.h>
+#include <7Semi_SCD4x_Queue.h>
+
+SCD4x_7Semi scd;
+SCD4x_Queue_7Semi queue(scd);
+
+// Wanted temperature offset as the sensor word: 4 °C · 65535 / 175
+const uint16_t T_OFFSET_RAW = 1498;
+
+void onSample(const SCD4x_RawSample_7Semi &s) {
+  Serial.print(F("CO2 "));
+  Serial.print(s.co2Ppm());
+  Serial.print(F(" ppm  T "));
+  Serial.print(s.tempC(), 2);
+  Serial.print(F(" C  RH "));
+  Serial.print(s.rhPercent(), 2);
+  Serial.println(F(" %"));
+}
+
+void onDone(const SCD4x_QueueResult_7Semi &r) {
+  // Write the offset only if it differs, and persist only after a write
+  if (r.op == SCD4x_Queue_7Semi::GET_TEMPERATURE_OFFSET && r.ok && r.value != T_OFFSET_RAW)
+    queue.enqueue(SCD4x_Queue_7Semi::SET_TEMPERATURE_OFFSET, 1, 0, T_OFFSET_RAW);
+  if (r.op == SCD4x_Queue_7Semi::SET_TEMPERATURE_OFFSET && r.ok)
+    queue.enqueue(SCD4x_Queue_7Semi::PERSIST_SETTINGS);
+
+  if (r.op == SCD4x_Queue_7Semi::SET_AMBIENT_PRESSURE && r.ok && !r.late) return;
+  Serial.print(F("op "));
+  Serial.print(r.op);
+  Serial.print(r.ok ? F(" ok") : F(" FAILED"));
+  Serial.print(F("  value "));
+  Serial.print(r.value);
+  Serial.print(F("  waited "));
+  Serial.print(r.waitMs);
+  Serial.println(r.late ? F(" ms  LATE") : F(" ms"));
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    ;
+
+  Serial.println(F("7Semi SCD4x\n Command queue"));
+
+  while (!scd.begin()) {
+    Serial.println(F("Sensor not detected."));
+    delay(1000);
+  }
+
+  queue.onSample(onSample);
+  queue.onDone(onDone);
+  if (!queue.startPeriodic()) {
+    Serial.println(F("startPeriodic failed"));
+    while (1) delay(1000);
+  }
+  queue.enqueue(SCD4x_Queue_7Semi::GET_TEMPERATURE_OFFSET, 1);
+}
+
+void loop() {
+  static uint32_t tPressure = 0, tMaint = 0, tStats = 0;
+  const uint32_t now = millis();
+
+  // Pressure from a barometer (fixed here), due within 2 s
+  if (now - tPressure >= 10000) {
+    tPressure = now;
+    queue.enqueue(SCD4x_Queue_7Semi::SET_AMBIENT_PRESSURE, 2, now + 2000, 1013);
+  }
+
+  // Read-only maintenance every 10 min, no hurry
+  if (now - tMaint >= 600000UL) {
+    tMaint = now;
+    queue.enqueue(SCD4x_Queue_7Semi::GET_ASC_ENABLED, 1, now + 30000);
+    queue.enqueue(SCD4x_Queue_7Semi::GET_SENSOR_VARIANT, 1, now + 30000);
+  }
+
+  if (now - tStats >= 30000) {
+    tStats = now;
+    const SCD4x_QueueStats_7Semi &s = queue.stats();
+    Serial.print(F("queue depth "));
+    Serial.print(s.depth);
+    Serial.print(F(" (max "));
+    Serial.print(s.maxDepth);
+    Serial.print(F(")  deferred "));
+    Serial.print(s.deferred);
+    Serial.print(F("  misses "));
+    Serial.print(s.deadlineMisses);
+    Serial.print(F("  late samples "));
+    Serial.print(s.lateSamples);
+    Serial.print(F("  max lag "));
+    Serial.print(s.maxSampleLagMs);
+    Serial.println(F(" ms"));
+  }
+
+  queue.update();
+}
@@ -0,0 +1,78 @@
+/***************************************************************
+ * @file    Occupancy.ino
+ * @brief   Example estimating room occupancy from the 7Semi SCD4x
+ *          CO₂ stream with a single-zone mass-balance model.
+ *
+ * Features demonstrated:
+ *  - Periodic measurement with data-ready polling
+ *  - SCD4x_Occupancy_7Semi: filtered CO₂, generation rate, head count
+ *
+ * Model configuration used:
+ * - Room volume     : 60 m³
+ * - Ventilation     : 1.5 ACH (ach_x100 = 150)
+ * - Outdoor CO₂     : 420 ppm
+ * - Data Output     : CO₂ (ppm), filtered CO₂, G (mL/min), persons
+ *
+ * Notes:
+ * - Estimates settle after a few minutes; accuracy depends on the
+ *   ventilation figure, so calibrate ACH against a known head count.
+ * - The default filter (shift 4) suits 5 s periodic samples; with
+ *   low-power periodic (30 s) call occ.setFilterShift(2).
+ *
+ * Connections:
+ * - SDA -> Default board SDA
+ * - SCL -> Default board SCL
+ * - VIN -> 3.3V / 5V (depending on module)
+ * - GND -> GND
+ *
+ * @author   7Semi
+ * @license  MIT
+ * @version  1.0
+ ***************************************************************/
+
+#include <7Semi_SCD4x.h>
+#include <7Semi_SCD4x_Occupancy.h>
+
+SCD4x_7Semi scd;
+SCD4x_Occupancy_7Semi occ(60, 150, 420);
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    ;
+
+  Serial.println(F("7Semi SCD4x\n Occupancy estimation"));
+
+  while (!scd.begin()) {
+    Serial.println(F("Sensor not detected."));
+    delay(1000);
+  }
+
+  if (!scd.startPeriodicMeasurement()) {
+    Serial.println(F("startPeriodicMeasurement failed"));
+    while (1) delay(1000);
+  }
+  Serial.println(F("Started. First valid reading in ~5s."));
+}
+
+void loop() {
+  static uint32_t t = 0;
+  if (millis() - t < 1000) return;  // poll every ~1 s
+  t = millis();
+
+  uint16_t st = 0;
+  if (scd.getDataReadyStatus(st) && (st & 0x07FF)) {
+    uint16_t co2;
+    float tc, rh;
+    if (scd.readMeasurement(co2, tc, rh) && occ.update(co2, millis())) {
+      Serial.print(F("CO2 "));
+      Serial.print(co2);
+      Serial.print(F(" ppm  filt "));
+      Serial.print(occ.filteredPpm());
+      Serial.print(F(" ppm  G "));
+      Serial.print(occ.generationMlPerMin());
+      Serial.print(F(" mL/min  persons "));
+      Serial.println(occ.occupancy());
+    }
+  }
+}
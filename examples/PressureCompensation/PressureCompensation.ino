@@ -0,0 +1,99 @@
+/***************************************************************
+ * @file    PressureCompensation.ino
+ * @brief   Example of software CO₂ pressure compensation from a
+ *          barometer (SCD4x_Pressure_7Semi): live pressure costs no
+ *          I²C writes, the sensor is updated only on large drift.
+ *
+ * Features demonstrated:
+ *  - Sensor reference from the installation altitude
+ *  - Barometer fed every second, CO₂ corrected per sample
+ *  - Fallback push (setAmbientPressureRaw) when pressure drifts more
+ *    than 10 hPa, at most once a minute
+ *  - Gain, reference and push counters
+ *
+ * Connections:
+ * - SDA -> Default board SDA (shared with the barometer)
+ * - SCL -> Default board SCL
+ * - VIN -> 3.3V / 5V (depending on module)
+ * - GND -> GND
+ *
+ * @author   7Semi
+ * @license  MIT
+ * @version  1.0
+ ***************************************************************/
+
+#include <7Semi_SCD4x.h>
+#include <7Semi_SCD4x_Pressure.h>
+
+const uint16_t ALTITUDE_M = 310;
+
+SCD4x_7Semi scd;
+SCD4x_Pressure_7Semi press(&scd);
+
+/**
+ * Replace with your barometer (BMP280, LPS22, ...), in Pa.
+ * A slow swing around the altitude pressure stands in here.
+ */
+uint32_t readBarometerPa() {
+  return 97660UL + (uint32_t)(1500.0f * (1.0f + sinf(millis() / 600000.0f)));
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    ;
+
+  Serial.println(F("7Semi SCD4x\n Software pressure compensation"));
+
+  while (!scd.begin()) {
+    Serial.println(F("Sensor not detected."));
+    delay(1000);
+  }
+
+  scd.setSensorAltitude(ALTITUDE_M);
+  press.setReferenceAltitude(ALTITUDE_M);
+  press.setFallback(1000, 60000);  // 10 hPa, once a minute
+
+  if (!scd.startPeriodicMeasurement()) {
+    Serial.println(F("startPeriodicMeasurement failed"));
+    while (1) delay(1000);
+  }
+}
+
+void loop() {
+  static uint32_t tBaro = 0, tPoll = 0;
+  const uint32_t now = millis();
+
+  if (now - tBaro >= 1000) {
+    tBaro = now;
+    if (press.update(readBarometerPa(), now)) {
+      Serial.print(F("pushed "));
+      Serial.print(press.reference() / 100);
+      Serial.println(F(" hPa to the sensor"));
+    }
+  }
+
+  if (now - tPoll < 1000) return;
+  tPoll = now;
+  uint16_t st = 0;
+  if (!scd.getDataReadyStatus(st) || !(st & 0x07FF)) return;
+
+  SCD4x_RawSample_7Semi s;
+  if (!scd.readMeasurementRaw(s.co2_raw, s.t_raw, s.rh_raw)) return;
+  s.t_ms = now;
+
+  Serial.print(F("CO2 "));
+  Serial.print(s.co2Ppm());
+  Serial.print(F(" -> "));
+  Serial.print(press.compensate(s));
+  Serial.print(F(" ppm  p "));
+  Serial.print(press.pressure() / 100.0f, 1);
+  Serial.print(F(" hPa  ref "));
+  Serial.print(press.reference() / 100.0f, 1);
+  Serial.print(F(" hPa  gain "));
+  Serial.print(press.gainQ14() / 16384.0f, 4);
+  Serial.print(F("  pushes "));
+  Serial.print(press.stats().pushes);
+  Serial.print(F("/"));
+  Serial.println(press.stats().updates);
+}
@@ -0,0 +1,99 @@
+/***************************************************************
+ * @file    ProfileStore.ino
+ * @brief   Example of per-serial calibration profiles kept in
+ *          EEPROM and restored by begin() (SCD4x_ProfileStore_7Semi).
+ *
+ * Features demonstrated:
+ *  - EEPROM adapter (commit() on ESP32 / ESP8266 / RP2040)
+ *  - Profile keyed by the sensor serial: temperature offset,
+ *    altitude, software CO₂ gain / offset and self-heating
+ *    coefficients
+ *  - CO₂ correction applied to each reading (active().correctCo2())
+ *  - Boot-time diff-apply: settings written and persisted only on
+ *    the first boot; later boots report UNCHANGED (no NVM writes)
+ *
+ * Connections:
+ * - SDA -> Default board SDA
+ * - SCL -> Default board SCL
+ * - VIN -> 3.3V / 5V (depending on module)
+ * - GND -> GND
+ *
+ * @author   7Semi
+ * @license  MIT
+ * @version  1.0
+ ***************************************************************/
+
+#include <EEPROM.h>
+#include <7Semi_SCD4x.h>
+#include <7Semi_SCD4x_Profile.h>
+
+SCD4x_7Semi scd;
+SCD4x_EepromStorage_7Semi<EEPROMClass> storage(EEPROM);
+SCD4x_ProfileStore_7Semi store(storage, 0, 4);  // bytes 0..111
+
+static const char *RESULT[] = { "no profile", "unchanged", "applied", "FAILED" };
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    ;
+
+  Serial.println(F("7Semi SCD4x\n Profile store"));
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266) || defined(ARDUINO_ARCH_RP2040)
+  EEPROM.begin(256);
+#endif
+
+  scd.setProfileStore(&store);
+  while (!scd.begin()) {
+    Serial.println(F("Sensor not detected."));
+    delay(1000);
+  }
+
+  uint64_t sn = 0;
+  scd.readSerialNumber(sn);
+  Serial.print(F("Serial 0x"));
+  Serial.print((uint32_t)(sn >> 32), HEX);
+  Serial.println((uint32_t)sn, HEX);
+
+  Serial.print(F("Profile: "));
+  Serial.println(RESULT[store.lastResult()]);
+
+  // First run: no profile yet, store one and reboot to see it applied
+  if (!store.hasActive()) {
+    SCD4x_Profile_7Semi p;
+    p.serial = sn;
+    p.setTemperatureOffset(2.75f);
+    p.setAltitude(310);
+    p.setCo2Correction(16548, -12);  // +1 % gain, -12 ppm (reference check)
+    p.setSelfHeating(120, 40);
+    Serial.println(store.save(p) ? F("Profile saved, reset the board") : F("Profile save failed"));
+    while (1) delay(1000);
+  }
+
+  Serial.print(F("Settings written "));
+  Serial.print(store.lastChanged(), HEX);
+  Serial.print(F("  persists "));
+  Serial.println(store.sensorPersists());
+  Serial.print(F("Self-heating (0.01 C) periodic "));
+  Serial.print(store.active().selfHeatStd);
+  Serial.print(F("  low-power "));
+  Serial.println(store.active().selfHeatLp);
+
+  scd.startPeriodicMeasurement();
+}
+
+void loop() {
+  uint16_t co2;
+  float t, rh;
+  if (scd.readMeasurement(co2, t, rh)) {
+    Serial.print(F("CO2 "));
+    Serial.print(store.active().correctCo2(co2));
+    Serial.print(F(" ppm  T "));
+    Serial.print(t, 2);
+    Serial.print(F(" C  RH "));
+    Serial.print(rh, 2);
+    Serial.println(F(" %"));
+  }
+  delay(5000);
+}
@@ -0,0 +1,111 @@
+/***************************************************************
+ * @file    Psychrometrics_Benchmark.ino
+ * @brief   Benchmark of the table-driven psychrometric metrics
+ *          (SCD4x_Psychro_7Semi) against logf/expf, plus live
+ *          dew point / absolute humidity / enthalpy output.
+ *
+ * Features demonstrated:
+ *  - Float and fixed-point dew point / absolute humidity
+ *  - Timing (µs per call) versus libm reference
+ *  - Max dew-point error over the SCD4x operating range
+ *
+ * Notes:
+ * - No sensor needed for the benchmark; live output starts only
+ *   if the SCD4x is detected.
+ * - Fixed-point inputs are 0.01 °C and 0.01 %RH.
+ *
+ * @author   7Semi
+ * @license  MIT
+ * @version  1.0
+ ***************************************************************/
+
+#include <7Semi_SCD4x.h>
+#include <7Semi_SCD4x_Psychro.h>
+
+SCD4x_7Semi scd;
+bool sensorOk = false;
+
+// Keep results observable so the compiler cannot drop the loops
+volatile float sinkF;
+volatile int32_t sinkI;
+
+const uint16_t N_CALLS = 1000;
+
+/**
+ * - Time N_CALLS calls of a float (t, rh) → float function
+ * - return : µs per call × 100
+ */
+uint32_t timeFloat(float (*fn)(float, float)) {
+  uint32_t t0 = micros();
+  for (uint16_t i = 0; i < N_CALLS; ++i)
+    sinkF = fn(-10.0f + (i % 70), 5.0f + (i % 95));
+  return (micros() - t0) * 100UL / N_CALLS;
+}
+
+void printUs(const __FlashStringHelper *name, uint32_t us_x100) {
+  Serial.print(name);
+  Serial.print(us_x100 / 100);
+  Serial.print('.');
+  if (us_x100 % 100 < 10) Serial.print('0');
+  Serial.print(us_x100 % 100);
+  Serial.println(F(" us/call"));
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    ;
+
+  Serial.println(F("7Semi SCD4x\n Psychrometrics benchmark"));
+
+  printUs(F("dewPoint (libm)        : "), timeFloat(SCD4x_Psychro_7Semi::dewPointReference));
+  printUs(F("dewPoint (table)       : "), timeFloat(SCD4x_Psychro_7Semi::dewPoint));
+  printUs(F("absHumidity (libm)     : "), timeFloat(SCD4x_Psychro_7Semi::absoluteHumidityReference));
+  printUs(F("absHumidity (table)    : "), timeFloat(SCD4x_Psychro_7Semi::absoluteHumidity));
+
+  uint32_t t0 = micros();
+  for (uint16_t i = 0; i < N_CALLS; ++i)
+    sinkI = SCD4x_Psychro_7Semi::dewPointFixed(-1000 + (i % 70) * 100, 500 + (i % 95) * 100);
+  printUs(F("dewPointFixed          : "), (micros() - t0) * 100UL / N_CALLS);
+
+  // Max dew-point error over -10..60 °C, 1..100 %RH
+  float maxErr = 0.0f;
+  for (int t = -10; t <= 60; t += 2) {
+    for (int rh = 1; rh <= 100; rh += 3) {
+      float ref = SCD4x_Psychro_7Semi::dewPointReference(t, rh);
+      if (ref < -40.0f) continue;
+      float err = fabsf(SCD4x_Psychro_7Semi::dewPoint(t, rh) - ref);
+      if (err > maxErr) maxErr = err;
+    }
+  }
+  Serial.print(F("max |dew point err|    : "));
+  Serial.print(maxErr, 4);
+  Serial.println(F(" C"));
+
+  sensorOk = scd.begin() && scd.startPeriodicMeasurement();
+  if (!sensorOk) Serial.println(F("Sensor not detected; benchmark only."));
+}
+
+void loop() {
+  if (!sensorOk) return;
+
+  static uint32_t t = 0;
+  if (millis() - t < 5000) return;  // one periodic sample every ~5 s
+  t = millis();
+
+  uint16_t co2;
+  float tc, rh;
+  if (!scd.readMeasurement(co2, tc, rh)) return;
+
+  Serial.print(F("T "));
+  Serial.print(tc, 2);
+  Serial.print(F(" C  RH "));
+  Serial.print(rh, 1);
+  Serial.print(F(" %  Td "));
+  Serial.print(SCD4x_Psychro_7Semi::dewPoint(tc, rh), 2);
+  Serial.print(F(" C  AH "));
+  Serial.print(SCD4x_Psychro_7Semi::absoluteHumidity(tc, rh), 2);
+  Serial.print(F(" g/m3  h "));
+  Serial.print(SCD4x_Psychro_7Semi::enthalpy(tc, rh), 1);
+  Serial.println(F(" kJ/kg"));
+}
@@ -0,0 +1,113 @@
+/***************************************************************
+ * @file    SampleLog.ino
+ * @brief   Example appending raw SCD4x samples to a CRC-protected,
+ *          double-buffered block log on LittleFS (ESP32 / ESP8266).
+ *
+ * Features demonstrated:
+ *  - Header block with serial, variant and configuration (captureInfo)
+ *  - readSerialNumber() tag on every block
+ *  - SCD4x_Log_7Semi with two 512-byte pages (delta encoding)
+ *  - Max page age 5 min (loss window) and sync every 4 blocks
+ *  - Crash recovery: reopening resumes after the last valid block
+ *  - A log written by another sensor (serial mismatch) is refused
+ *  - Read the file on a PC with extras/host/scd4x_log_reader.h
+ *
+ * Notes:
+ * - The file must be opened read/write without O_APPEND ("r+"), so a
+ *   torn tail can be overwritten. The classic Arduino SD library opens
+ *   FILE_WRITE with O_APPEND; use SdFat (O_RDWR | O_CREAT) there.
+ * - service() runs in loop() here; on ESP32 it can run in its own task.
+ *   Then call requestFlush() from the producer instead of flush().
+ *
+ * Connections:
+ * - SDA -> Default board SDA
+ * - SCL -> Default board SCL
+ * - VIN -> 3.3V / 5V (depending on module)
+ * - GND -> GND
+ *
+ * @author   7Semi
+ * @license  MIT
+ * @version  1.0
+ ***************************************************************/
+
+#include <FS.h>
+#include <LittleFS.h>
+#include <7Semi_SCD4x.h>
+#include <7Semi_SCD4x_Log.h>
+
+const char *LOG_PATH = "/scd4x.log";
+const uint16_t BLOCK = 512;
+
+SCD4x_7Semi scd;
+uint8_t pageA[BLOCK], pageB[BLOCK];
+SCD4x_Log_7Semi logw(pageA, pageB, BLOCK, SCD4X_LOG_ENC_DELTA);
+
+File file;
+SCD4x_FileStorage_7Semi<File> storage(file);
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    ;
+
+  Serial.println(F("7Semi SCD4x\n Sample log"));
+
+  // Mount, formatting on first use (the begin() signature differs per core)
+#if defined(ARDUINO_ARCH_ESP32)
+  bool mounted = LittleFS.begin(true);
+#else
+  bool mounted = LittleFS.begin() || (LittleFS.format() && LittleFS.begin());
+#endif
+  if (!mounted) {
+    Serial.println(F("LittleFS mount failed"));
+    while (1) delay(1000);
+  }
+  if (!LittleFS.exists(LOG_PATH)) LittleFS.open(LOG_PATH, "w").close();
+  file = LittleFS.open(LOG_PATH, "r+");
+
+  while (!scd.begin()) {
+    Serial.println(F("Sensor not detected."));
+    delay(1000);
+  }
+
+  // Sensor identity + configuration, captured before the log is opened:
+  // written into the header of a new file, serial checked on reopen
+  SCD4x_LogInfo_7Semi info;
+  if (!SCD4x_Log_7Semi::captureInfo(scd, info)) {
+    Serial.println(F("captureInfo failed"));
+    while (1) delay(1000);
+  }
+  info.mode = 1;  // periodic
+  info.periodMs = 5000;
+  if (!logw.begin(storage, info)) {
+    if (logw.beginStatus() == SCD4x_Log_7Semi::BEGIN_SERIAL_MISMATCH)
+      Serial.println(F("log belongs to another sensor"));
+    else
+      Serial.println(F("log recovery failed"));
+    while (1) delay(1000);
+  }
+  logw.setMaxAge(5UL * 60UL * 1000UL);
+  logw.setSyncEvery(4);
+
+  Serial.print(F("Resuming at block "));
+  Serial.println(logw.nextSequence());
+
+  scd.startPeriodicMeasurement();
+}
+
+void loop() {
+  static uint32_t t = 0;
+  logw.poll(millis());
+  logw.service();
+
+  if (millis() - t < 1000) return;  // poll data-ready every ~1 s
+  t = millis();
+
+  uint16_t st = 0;
+  if (!scd.getDataReadyStatus(st) || !(st & 0x07FF)) return;
+
+  SCD4x_RawSample_7Semi s;
+  if (!scd.readMeasurementRaw(s.co2_raw, s.t_raw, s.rh_raw)) return;
+  s.t_ms = millis();
+  if (!logw.append(s)) Serial.println(F("sample dropped"));
+}
@@ -0,0 +1,102 @@
+/***************************************************************
+ * @file    SelfHeating.ino
+ * @brief   Example of software self-heating correction
+ *          (SCD4x_SelfHeat_7Semi): T / RH corrected per measurement
+ *          mode and radio duty cycle, without stopping measurement.
+ *
+ * Features demonstrated:
+ *  - Per-mode offsets plus a duty-cycle slope
+ *  - Duty cycle tracked from radio on/off events (thermal lag)
+ *  - RH recomputed for the corrected temperature
+ *  - Offsets learned from a reference thermometer while measuring
+ *
+ * Connections:
+ * - SDA -> Default board SDA
+ * - SCL -> Default board SCL
+ * - VIN -> 3.3V / 5V (depending on module)
+ * - GND -> GND
+ *
+ * @author   7Semi
+ * @license  MIT
+ * @version  1.0
+ ***************************************************************/
+
+#include <7Semi_SCD4x.h>
+#include <7Semi_SCD4x_SelfHeat.h>
+
+SCD4x_7Semi scd;
+SCD4x_SelfHeat_7Semi selfHeat;
+
+/**
+ * Replace with a co-located reference thermometer (°C), or return NAN
+ * once the offsets are learned.
+ */
+float readReferenceC() {
+  return NAN;
+}
+
+/** Stand-in for a radio: transmit 2 s out of every 10 s */
+bool radioTransmitting() {
+  return (millis() % 10000) < 2000;
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    ;
+
+  Serial.println(F("7Semi SCD4x\n Software self-heating correction"));
+
+  while (!scd.begin()) {
+    Serial.println(F("Sensor not detected."));
+    delay(1000);
+  }
+
+  // Starting point: 0.60 C in periodic mode, +0.90 C more at full duty
+  selfHeat.setOffset(SCD4x_SelfHeat_7Semi::PERIODIC, 60, 90);
+  selfHeat.setOffset(SCD4x_SelfHeat_7Semi::LOW_POWER, 20, 90);
+  selfHeat.setMode(SCD4x_SelfHeat_7Semi::PERIODIC);
+
+  if (!scd.startPeriodicMeasurement()) {
+    Serial.println(F("startPeriodicMeasurement failed"));
+    while (1) delay(1000);
+  }
+}
+
+void loop() {
+  static uint32_t tPoll = 0;
+  const uint32_t now = millis();
+
+  selfHeat.radio(radioTransmitting(), now);
+
+  if (now - tPoll < 1000) return;
+  tPoll = now;
+  uint16_t st = 0;
+  if (!scd.getDataReadyStatus(st) || !(st & 0x07FF)) return;
+
+  uint16_t co2;
+  float t, rh;
+  if (!scd.readMeasurement(co2, t, rh)) return;
+
+  const float ref = readReferenceC();
+  if (!isnan(ref)) selfHeat.learn(t, ref);
+
+  float tc = t, rhc = rh;
+  selfHeat.correct(tc, rhc);
+
+  Serial.print(F("CO2 "));
+  Serial.print(co2);
+  Serial.print(F(" ppm  T "));
+  Serial.print(t, 2);
+  Serial.print(F(" -> "));
+  Serial.print(tc, 2);
+  Serial.print(F(" C  RH "));
+  Serial.print(rh, 1);
+  Serial.print(F(" -> "));
+  Serial.print(rhc, 1);
+  Serial.print(F(" %  duty "));
+  Serial.print(selfHeat.duty() / 10.0f, 1);
+  Serial.print(F(" %  offset "));
+  Serial.print(selfHeat.offsetCenti() / 100.0f, 2);
+  Serial.println(F(" C"));
+}
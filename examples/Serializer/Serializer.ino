@@ -0,0 +1,81 @@
+/***************************************************************
+ * @file    Serializer.ino
+ * @brief   Example streaming SCD4x samples as JSON or CSV with
+ *          SCD4x_Serializer_7Semi (no float printing, no String).
+ *
+ * Features demonstrated:
+ *  - readMeasurementRaw() → SCD4x_RawSample_7Semi
+ *  - One Print::write() per record instead of six Serial.print()
+ *  - Batch output of buffered samples as one JSON array
+ *  - Throughput report (bytes per ms of formatting + writing)
+ *
+ * Sensor configuration used:
+ * - Mode            : Periodic (5 s)
+ * - Output          : JSON per sample; CSV batch every 12 samples
+ *
+ * Connections:
+ * - SDA -> Default board SDA
+ * - SCL -> Default board SCL
+ * - VIN -> 3.3V / 5V (depending on module)
+ * - GND -> GND
+ *
+ * @author   7Semi
+ * @license  MIT
+ * @version  1.0
+ ***************************************************************/
+
+#include <7Semi_SCD4x.h>
+#include <7Semi_SCD4x_Serializer.h>
+
+SCD4x_7Semi scd;
+SCD4x_Serializer_7Semi out(Serial, SCD4x_Serializer_7Semi::JSON);
+
+const uint8_t BATCH = 12;
+SCD4x_RawSample_7Semi batch[BATCH];
+uint8_t nbatch = 0;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    ;
+
+  Serial.println(F("7Semi SCD4x\n Serializer"));
+
+  while (!scd.begin()) {
+    Serial.println(F("Sensor not detected."));
+    delay(1000);
+  }
+
+  if (!scd.startPeriodicMeasurement()) {
+    Serial.println(F("startPeriodicMeasurement failed"));
+    while (1) delay(1000);
+  }
+}
+
+void loop() {
+  static uint32_t t = 0;
+  if (millis() - t < 1000) return;  // poll every ~1 s
+  t = millis();
+
+  uint16_t st = 0;
+  if (!scd.getDataReadyStatus(st) || !(st & 0x07FF)) return;
+
+  SCD4x_RawSample_7Semi s;
+  if (!scd.readMeasurementRaw(s.co2_raw, s.t_raw, s.rh_raw)) return;
+  s.t_ms = millis();
+
+  out.setFormat(SCD4x_Serializer_7Semi::JSON);
+  out.write(s);
+
+  batch[nbatch++] = s;
+  if (nbatch == BATCH) {
+    out.setFormat(SCD4x_Serializer_7Semi::CSV);
+    out.writeHeader();
+    out.writeBatch(batch, nbatch);
+    nbatch = 0;
+
+    Serial.print(F("# serializer throughput "));
+    Serial.print(out.bytesPerMs());
+    Serial.println(F(" bytes/ms"));
+  }
+}
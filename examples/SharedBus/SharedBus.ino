@@ -0,0 +1,99 @@
+/***************************************************************
+ * @file    SharedBus.ino
+ * @brief   Example of an SCD4x sharing one I²C bus with another
+ *          device and another task (SCD4x_BusArbiter_7Semi, ESP32).
+ *
+ * Features demonstrated:
+ *  - Arbiter task owning Wire; driver routed through setArbiter()
+ *  - A second task polling another device (RTC at 0x68) at higher
+ *    priority with a deadline, via raw transact() units
+ *  - Forced recalibration on the SCD4x (400 ms) without stalling
+ *    the RTC task: its units run in the execution-time gap
+ *  - Arbiter statistics (gap fills, late units, worst queueing)
+ *
+ * Connections:
+ * - SDA -> Default board SDA
+ * - SCL -> Default board SCL
+ * - VIN -> 3.3V / 5V (depending on module)
+ * - GND -> GND
+ * - Optional: DS3231 / DS1307 RTC on the same bus
+ *
+ * @author   7Semi
+ * @license  MIT
+ * @version  1.0
+ ***************************************************************/
+
+#include <7Semi_SCD4x.h>
+
+#if !defined(ARDUINO_ARCH_ESP32)
+#error "SharedBus needs ESP32 (FreeRTOS tasks)"
+#endif
+
+SCD4x_7Semi scd;
+SCD4x_BusArbiter_7Semi arb;
+
+// RTC seconds register read every 100 ms, due within 20 ms
+void rtcTask(void *) {
+  uint8_t reg = 0x00, sec = 0;
+  uint32_t reads = 0, fails = 0;
+  for (;;) {
+    SCD4x_BusUnit_7Semi u = {};
+    u.address = 0x68;
+    u.priority = 3;  // above the SCD4x (1)
+    u.tx = &reg;
+    u.txLen = 1;
+    u.rx = &sec;
+    u.rxLen = 1;
+    u.deadlineMs = millis() + 20;
+    if (arb.transact(u)) ++reads;
+    else ++fails;
+    if ((reads + fails) % 50 == 0) {
+      Serial.printf("RTC reads %lu fails %lu  last queued %lu us\n", (unsigned long)reads, (unsigned long)fails,
+                    (unsigned long)u.queuedUs);
+    }
+    vTaskDelay(pdMS_TO_TICKS(100));
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    ;
+
+  Serial.println(F("7Semi SCD4x\n Shared bus arbiter"));
+
+  while (!scd.begin()) {
+    Serial.println(F("Sensor not detected."));
+    delay(1000);
+  }
+
+  arb.begin(&Wire);
+  arb.startTask();
+  scd.setArbiter(&arb);
+
+  // Idle sensor: FRC runs as one unit while the RTC keeps being served
+  xTaskCreate(rtcTask, "rtc", 3072, nullptr, 2, nullptr);
+  uint16_t frc = 0;
+  if (scd.performForcedRecalibration(420, &frc)) {
+    Serial.print(F("FRC correction "));
+    Serial.println((int32_t)frc - 0x8000);
+  }
+
+  if (!scd.startPeriodicMeasurement()) {
+    Serial.println(F("startPeriodicMeasurement failed"));
+    while (1) delay(1000);
+  }
+}
+
+void loop() {
+  delay(5000);
+  uint16_t co2;
+  float tc, rh;
+  if (scd.readMeasurement(co2, tc, rh)) {
+    Serial.printf("CO2 %u ppm  T %.2f C  RH %.2f %%\n", co2, tc, rh);
+  }
+  const SCD4x_BusStats_7Semi &s = arb.stats();
+  Serial.printf("bus units %lu errors %lu late %lu gapFills %lu maxQueued %lu us\n", (unsigned long)s.units,
+                (unsigned long)s.errors, (unsigned long)s.late, (unsigned long)s.gapFills,
+                (unsigned long)s.maxQueuedUs);
+}
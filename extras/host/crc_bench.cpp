@@ -0,0 +1,83 @@
+/**
+ * crc_bench.cpp
+ * -------------
+ * Host benchmark: bulk [MSB, LSB, CRC] word validation
+ *
+ * Build / run
+ * -----------
+ *   g++ -O2 -std=c++17 -march=native crc_bench.cpp -o crc_bench
+ *   ./crc_bench [million_words] [bad_per_million]
+ *
+ * Output
+ * ------
+ * - Throughput of the per-word crc8() loop, the slicing-by-2 table path and
+ *   validate() (SSSE3 when compiled in), in M words/s and GB/s
+ * - Bitmap agreement between all three paths
+ *
+ * Typical (-O2 -march=native, default 16 M words = 48 MB): crc8 loop
+ * ~90 M words/s; table ~1.2–1.3 G words/s (~13x); SSSE3 23x to 39x over
+ * the crc8 loop depending on the machine (memory bound at 48 MB, ~40x on
+ * 1 M words in cache).
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "scd4x_crc_bulk.h"
+
+typedef size_t (*ValidateFn)(const uint8_t *, size_t, uint8_t *);
+
+static double bestMs(ValidateFn f, const uint8_t *w, size_t n, uint8_t *bad, size_t &nBad) {
+  double best = 1e30;
+  for (int r = 0; r < 5; ++r) {
+    auto t0 = std::chrono::steady_clock::now();
+    nBad = f(w, n, bad);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    if (ms < best) best = ms;
+  }
+  return best;
+}
+
+int main(int argc, char **argv) {
+  const size_t n = (size_t)((argc > 1) ? atof(argv[1]) : 16.0) * 1000000;
+  const unsigned badPpm = (argc > 2) ? (unsigned)atoi(argv[2]) : 1000;
+
+  // Valid words, then flip one random bit in ~badPpm per million
+  std::vector<uint8_t> w(n * 3 + 16);
+  uint32_t x = 12345;
+  auto rnd = [&]() { x ^= x << 13; x ^= x >> 17; x ^= x << 5; return x; };
+  size_t injected = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const uint32_t r = rnd();
+    w[3 * i] = (uint8_t)r;
+    w[3 * i + 1] = (uint8_t)(r >> 8);
+    w[3 * i + 2] = Scd4xCrcBulk::crc8(w[3 * i], w[3 * i + 1]);
+    if (rnd() % 1000000 < badPpm) {
+      w[3 * i + rnd() % 3] ^= (uint8_t)(1 << (rnd() % 8));
+      ++injected;
+    }
+  }
+
+  const size_t bytes = (n + 7) / 8;
+  std::vector<uint8_t> bRef(bytes), bTab(bytes), bBulk(bytes);
+  size_t nRef, nTab, nBulk;
+  const double tRef = bestMs(Scd4xCrcBulk::validateReference, w.data(), n, bRef.data(), nRef);
+  const double tTab = bestMs(Scd4xCrcBulk::validateTable, w.data(), n, bTab.data(), nTab);
+  const double tBulk = bestMs(Scd4xCrcBulk::validate, w.data(), n, bBulk.data(), nBulk);
+
+  const bool same = bRef == bTab && bRef == bBulk && nRef == nTab && nRef == nBulk;
+  auto line = [&](const char *name, double ms, size_t bad) {
+    printf("%-10s: %8.2f ms  %7.0f M words/s  %5.2f GB/s  (%zu bad)\n", name, ms, n / ms / 1000.0,
+           n * 3.0 / ms / 1e6, bad);
+  };
+  printf("%zu words, %zu corrupted (a 1-bit flip always breaks CRC-8)\n", n, injected);
+  line("crc8 loop", tRef, nRef);
+  line("table", tTab, nTab);
+  line(Scd4xCrcBulk::path(), tBulk, nBulk);
+  printf("bitmaps %s, speed-up %.1fx (table) / %.1fx (%s)\n", same ? "identical" : "DIFFER", tRef / tTab,
+         tRef / tBulk, Scd4xCrcBulk::path());
+  return (same && nRef == injected) ? 0 : 1;
+}
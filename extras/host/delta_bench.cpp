@@ -0,0 +1,88 @@
+/**
+ * delta_bench.cpp
+ * ---------------
+ * Host benchmark: lossless delta/zigzag/varint codec on simulated raw samples
+ *
+ * Build / run
+ * -----------
+ *   g++ -O2 -std=c++17 -I../../src delta_bench.cpp ../../src/7Semi_SCD4x_Delta.cpp -o delta_bench
+ *   ./delta_bench [days] [block_bytes]
+ *
+ * Output
+ * ------
+ * - Bytes per sample vs the 10 B baseline (3 raw words + uint32 timestamp)
+ * - Decode throughput (samples/s) and round-trip check
+ *
+ * Typical (30 days, 512 B blocks): ~4.6 B/sample (2.2x), >10 M samples/s
+ * decode. The simulator's RH noise (~66 raw LSB per step) needs 2-byte
+ * varints; quieter streams encode proportionally smaller.
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "7Semi_SCD4x_Delta.h"
+#include "scd4x_office_sim.h"
+
+int main(int argc, char **argv) {
+  const int days = (argc > 1) ? atoi(argv[1]) : 30;
+  const size_t blockBytes = (argc > 2) ? (size_t)atoi(argv[2]) : 512;
+
+  Scd4xOfficeSim sim(7);
+  const size_t n = (size_t)days * 86400 / 5;
+  std::vector<SCD4x_RawSample_7Semi> in(n);
+  for (size_t i = 0; i < n; ++i) {
+    Scd4xSimSample s = sim.next();
+    in[i] = { s.t_ms, s.co2_raw, s.t_raw, s.rh_raw };
+  }
+
+  // Encode into a contiguous log of blocks
+  std::vector<uint8_t> block(blockBytes), log;
+  SCD4x_DeltaEncoder_7Semi enc(block.data(), block.size());
+  size_t blocks = 0;
+  auto flush = [&]() {
+    size_t len = enc.finish();
+    log.insert(log.end(), block.begin(), block.begin() + len);
+    enc.restart();
+    ++blocks;
+  };
+  auto e0 = std::chrono::steady_clock::now();
+  for (const auto &s : in) {
+    if (!enc.add(s)) {
+      flush();
+      enc.add(s);
+    }
+  }
+  if (enc.count()) flush();
+  auto e1 = std::chrono::steady_clock::now();
+
+  // Decode, block by block
+  std::vector<SCD4x_RawSample_7Semi> out(n);
+  size_t k = 0;
+  auto d0 = std::chrono::steady_clock::now();
+  for (size_t off = 0; off < log.size();) {
+    size_t len = SCD4x_DeltaDecoder_7Semi::blockLength(log.data() + off, log.size() - off);
+    if (!len) break;
+    k += SCD4x_DeltaDecoder_7Semi::decodeBlock(log.data() + off, len, out.data() + k, n - k);
+    off += len;
+  }
+  auto d1 = std::chrono::steady_clock::now();
+
+  bool ok = (k == n);
+  for (size_t i = 0; ok && i < n; ++i)
+    ok = in[i].t_ms == out[i].t_ms && in[i].co2_raw == out[i].co2_raw &&
+         in[i].t_raw == out[i].t_raw && in[i].rh_raw == out[i].rh_raw;
+
+  const double enc_s = std::chrono::duration<double>(e1 - e0).count();
+  const double dec_s = std::chrono::duration<double>(d1 - d0).count();
+  printf("%zu samples, %zu blocks of <= %zu B\n", n, blocks, blockBytes);
+  printf("raw     : %zu B (10.00 B/sample)\n", n * 10);
+  printf("encoded : %zu B (%.2f B/sample, %.2fx)\n", log.size(), (double)log.size() / n,
+         (double)(n * 10) / log.size());
+  printf("encode  : %.1f M samples/s\n", n / enc_s / 1e6);
+  printf("decode  : %.1f M samples/s\n", n / dec_s / 1e6);
+  printf("roundtrip %s\n", ok ? "OK" : "MISMATCH");
+  return ok ? 0 : 1;
+}
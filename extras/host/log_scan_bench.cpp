@@ -0,0 +1,169 @@
+/**
+ * log_scan_bench.cpp
+ * ------------------
+ * Host benchmark: write a simulated log with SCD4x_Log_7Semi, then scan it
+ * through the memory-mapped reader
+ *
+ * Build / run
+ * -----------
+ *   g++ -O2 -std=c++17 -I../../src log_scan_bench.cpp ../../src/7Semi_SCD4x_Log.cpp \
+ *       ../../src/7Semi_SCD4x_Delta.cpp -o log_scan_bench
+ *   ./log_scan_bench [days] [block_bytes] [co2_threshold] [path]
+ *
+ * Output
+ * ------
+ * - File size and header block contents
+ * - Time to open + walk block headers, verify every CRC, decode everything,
+ *   and decode one day picked from the middle (lazy path)
+ * - Zone-map queries ("CO₂ ≥ threshold" over the whole log and over 30 days)
+ *   against a brute-force scan: matches, blocks decoded / skipped, time
+ *
+ * Typical (365 days, 512 B blocks, delta): 6.3 M samples in 31.5 MB;
+ * open + header walk ~3 ms (page faults included), CRC pass ~0.2 s,
+ * full decode ~0.6 s, one day ~2 ms. Delta blocks hold ≤ 255 samples, so
+ * blocks much larger than 1 KB mostly carry padding.
+ * CO₂ ≥ 1200 ppm over the year: 954 of 65 008 blocks decoded, ~11 ms vs
+ * ~0.56 s brute force; restricted to 30 days: 39 blocks, ~0.6 ms.
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "scd4x_log_reader.h"
+#include "scd4x_office_sim.h"
+#include "scd4x_posix_storage.h"
+
+static double msSince(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char **argv) {
+  const int days = (argc > 1) ? atoi(argv[1]) : 365;
+  const uint16_t blockBytes = (argc > 2) ? (uint16_t)atoi(argv[2]) : 512;
+  const uint16_t threshold = (argc > 3) ? (uint16_t)atoi(argv[3]) : 1200;
+  const char *path = (argc > 4) ? argv[4] : "scd4x_bench.log";
+
+  // ---- Write ----
+  {
+    Scd4xPosixStorage st;
+    if (!st.open(path, true)) {
+      printf("cannot open %s\n", path);
+      return 1;
+    }
+    std::vector<uint8_t> a(blockBytes), b(blockBytes);
+    SCD4x_Log_7Semi log(a.data(), b.data(), blockBytes, SCD4X_LOG_ENC_DELTA);
+    log.setSyncEvery(0);
+
+    SCD4x_LogInfo_7Semi info;
+    info.serial = 0x1234567890ABULL;
+    info.variant = 0x1440;
+    info.altitudeM = 120;
+    info.ascEnabled = 1;
+    info.ascTargetPpm = 400;
+    info.mode = 1;
+    info.periodMs = 5000;
+    if (!log.begin(st, info)) return 1;
+
+    Scd4xOfficeSim sim(7);
+    const size_t n = (size_t)days * 86400 / 5;
+    for (size_t i = 0; i < n; ++i) {
+      Scd4xSimSample s = sim.next();
+      log.append({ s.t_ms, s.co2_raw, s.t_raw, s.rh_raw });
+      log.service();
+    }
+    log.flush();
+    printf("wrote %zu samples, %u blocks\n", n, (unsigned)log.blocksWritten());
+  }
+
+  // ---- Open + header walk ----
+  Scd4xLogReader r;
+  auto t0 = std::chrono::steady_clock::now();
+  if (!r.open(path)) {
+    printf("reader: cannot open %s\n", path);
+    return 1;
+  }
+  uint64_t declared = 0;
+  for (Scd4xLogBlock blk : r) declared += blk.count();
+  const double tWalk = msSince(t0);
+
+  const SCD4x_LogInfo_7Semi &h = r.info();
+  printf("header: %s serial %012llX variant 0x%04X block %u enc %u period %u ms\n",
+         r.hasHeader() ? "yes" : "no", (unsigned long long)h.serial, h.variant, h.blockSize,
+         h.encoding, (unsigned)h.periodMs);
+  printf("%zu blocks, %llu samples declared\n", r.blockCount(), (unsigned long long)declared);
+
+  // ---- CRC pass ----
+  t0 = std::chrono::steady_clock::now();
+  size_t bad = 0;
+  for (Scd4xLogBlock blk : r)
+    if (!blk.valid()) ++bad;
+  const double tCrc = msSince(t0);
+
+  // ---- Full decode ----
+  t0 = std::chrono::steady_clock::now();
+  uint64_t sumCo2 = 0, lastT = 0;
+  const uint64_t total = r.forEachSample([&](uint64_t t, const SCD4x_RawSample_7Semi &s) {
+    sumCo2 += s.co2_raw;
+    lastT = t;
+  });
+  const double tAll = msSince(t0);
+
+  // ---- Lazy: one day from the middle ----
+  t0 = std::chrono::steady_clock::now();
+  const size_t perDay = r.blockCount() / (days ? days : 1);
+  const size_t from = r.blockCount() / 2;
+  uint64_t dayN = 0;
+  for (size_t i = from; i < from + perDay && i < r.blockCount(); ++i) {
+    Scd4xLogBlock blk = r.block(i);
+    if (blk.valid()) dayN += blk.decode([](const SCD4x_RawSample_7Semi &) {});
+  }
+  const double tDay = msSince(t0);
+
+  printf("open + header walk : %8.3f ms\n", tWalk);
+  printf("CRC all blocks     : %8.3f ms (%zu bad)\n", tCrc, bad);
+  printf("decode all         : %8.3f ms (%llu samples, %.1f M/s, span %.1f days, mean co2 %.0f)\n", tAll,
+         (unsigned long long)total, total / tAll / 1000.0, lastT / 86400000.0,
+         total ? (double)sumCo2 / total : 0.0);
+  printf("decode one day     : %8.3f ms (%llu samples)\n", tDay, (unsigned long long)dayN);
+
+  // ---- Zone-map queries vs brute force ----
+  Scd4xLogQuery q;
+  q.co2Lo = threshold;
+  const uint64_t day = 86400000ULL;
+  struct Case {
+    const char *name;
+    uint64_t from, to;
+  } cases[] = {
+    { "whole log", 0, UINT64_MAX },
+    { "30 days  ", (uint64_t)days / 2 * day, ((uint64_t)days / 2 + 30) * day - 1 },
+  };
+  for (const Case &c : cases) {
+    q.fromKey = c.from;
+    q.toKey = c.to;
+
+    t0 = std::chrono::steady_clock::now();
+    uint64_t brute = 0;
+    r.forEachSample([&](uint64_t t, const SCD4x_RawSample_7Semi &s) {
+      if (q.matches(t, s)) ++brute;
+    });
+    const double tBrute = msSince(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    uint64_t firstHit = UINT64_MAX;
+    const uint64_t hits = r.query(q, [&](uint64_t t, const SCD4x_RawSample_7Semi &) {
+      if (t < firstHit) firstHit = t;
+    });
+    const double tQuery = msSince(t0);
+    const Scd4xLogQueryStats &qs = r.queryStats();
+
+    printf("co2 >= %u, %s : %llu hits (brute %llu) | %zu blocks in range, %zu skipped, %zu decoded"
+           " | %.3f ms vs %.3f ms brute (%.0fx)\n",
+           threshold, c.name, (unsigned long long)hits, (unsigned long long)brute, qs.blocksInRange,
+           qs.blocksSkipped, qs.blocksDecoded, tQuery, tBrute, tQuery > 0 ? tBrute / tQuery : 0.0);
+    if (hits)
+      printf("  first hit at day %.2f\n", firstHit / (double)day);
+  }
+  return 0;
+}
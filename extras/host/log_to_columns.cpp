@@ -0,0 +1,64 @@
+/**
+ * log_to_columns.cpp
+ * ------------------
+ * Host tool: convert an SCD4x_Log_7Semi file into the columnar layout of
+ * scd4x_columnar.h
+ *
+ * Build / run
+ * -----------
+ *   g++ -O2 -std=c++17 -I../../src log_to_columns.cpp ../../src/7Semi_SCD4x_Log.cpp \
+ *       ../../src/7Semi_SCD4x_Delta.cpp -o log_to_columns
+ *   ./log_to_columns in.log out.s4c [chunk_rows]
+ *
+ * Options
+ * -------
+ * - chunk_rows : rows per chunk (default SCD4X_COL_CHUNK_ROWS = 4096, the
+ *   writer's default)
+ *
+ * Output
+ * ------
+ * - Rows, chunks, input / output size; blocks with a bad CRC are skipped
+ *   and counted.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "scd4x_columnar.h"
+#include "scd4x_log_reader.h"
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    printf("usage: %s in.log out.s4c [chunk_rows]\n", argv[0]);
+    return 2;
+  }
+  const uint32_t chunkRows = (argc > 3) ? (uint32_t)atoi(argv[3]) : SCD4X_COL_CHUNK_ROWS;
+
+  Scd4xLogReader r;
+  if (!r.open(argv[1])) {
+    printf("cannot read %s\n", argv[1]);
+    return 1;
+  }
+  Scd4xColumnWriter w(chunkRows);
+  if (!w.open(argv[2], r.info())) {
+    printf("cannot create %s\n", argv[2]);
+    return 1;
+  }
+  r.forEachSample([&](uint64_t key, const SCD4x_RawSample_7Semi &s) { w.add(key, s); });
+  const uint64_t rows = w.rows();
+  if (!w.close()) {
+    printf("write failed\n");
+    return 1;
+  }
+
+  Scd4xColumnReader c;
+  if (!c.open(argv[2])) {
+    printf("cannot reopen %s\n", argv[2]);
+    return 1;
+  }
+  printf("%llu rows, %u chunks, %zu bad blocks\n", (unsigned long long)rows, c.chunkCount(), r.badBlocks());
+  printf("log %zu blocks x %u B -> columns %llu B (%.2f B/row)\n", r.blockCount(), r.info().blockSize,
+         (unsigned long long)c.header().dirOffset + c.chunkCount() * sizeof(Scd4xColumnChunk),
+         rows ? (double)(c.header().dirOffset + c.chunkCount() * sizeof(Scd4xColumnChunk)) / rows : 0.0);
+  return 0;
+}
@@ -0,0 +1,186 @@
+/**
+ * occupancy_bench.cpp
+ * -------------------
+ * Host benchmark: SCD4x_Occupancy_7Semi against scripted occupancy with a
+ * known answer (step in, step out, ventilation change), with and without
+ * model mismatch, and a simulated office week
+ * (extras/host/scd4x_office_sim.h)
+ *
+ * Build / run
+ * -----------
+ *   g++ -O2 -std=c++17 -I../../src -Ishim occupancy_bench.cpp \
+ *       ../../src/7Semi_SCD4x_Occupancy.cpp -o occupancy_bench
+ *   ./occupancy_bench [shift] [period_s]
+ *
+ * Options
+ * -------
+ * - shift    : estimator EMA shift (default 4)
+ * - period_s : sample period (default 5 = periodic; 30 = low-power)
+ *
+ * Output
+ * ------
+ * - Per segment: true head count and ACH, mismatch factor k, settle time
+ *   (first time the error is within tolerance), then mean and RMS error
+ *   over the segment after the settle window.
+ * - The zone is a mass balance (120 m³, 420 ppm outdoor, 312 mL/min per
+ *   person) with the simulator's CO₂ noise. Matched runs give the
+ *   estimator the true V and ACH; mismatched runs set V 20 % low, or
+ *   change ACH without setVentilation(). Then
+ *   k = (V·ACH assumed) / (V·ACH true) and the estimate tends to k × truth.
+ * - Bound checked (as stated in 7Semi_SCD4x_Occupancy.h), with
+ *   m = |k − 1| × true head count (0 when matched): within 0.5 + m of
+ *   the truth within 20 min, then |mean| ≤ 0.5 + m and RMS ≤ 1 + m.
+ *   Exit status 1 if any segment breaks it.
+ * - Informational: mean absolute error over an office week.
+ *
+ * Typical (seed 42), matched: shift 4 @ 5 s settles in ≤ 5 min, RMS ≤ 0.6, office
+ * MAE 0.5 person while occupied; shift 2 @ 30 s settles in ≤ 6 min,
+ * RMS ≤ 0.9. shift 2 @ 5 s fails (RMS 3–4, noise through the derivative);
+ * shift 4 @ 30 s is accurate but takes ~30 min to settle.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "7Semi_SCD4x_Occupancy.h"
+#include "scd4x_office_sim.h"
+
+#define SETTLE_MIN  20    // settle window after each change (min)
+#define BOUND_MEAN  0.5   // |mean error| after settling (persons)
+#define BOUND_RMS   1.0   // RMS error after settling (persons)
+
+/** - Single-zone mass balance with the office simulator's CO₂ noise */
+struct Zone {
+  double volume = 120.0, ach = 1.2, co2 = 420.0;
+  uint32_t rng = 42;
+
+  uint16_t step(int people, double dt_s) {
+    co2 += dt_s * ((people * 312.0 / volume) / 60.0 - (ach / 3600.0) * (co2 - 420.0));
+    const double c = co2 + noise() * (3.0 + 0.01 * co2);
+    return (uint16_t)(c < 0 ? 0 : c + 0.5);
+  }
+  double uniform() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (rng >> 8) / 16777216.0;
+  }
+  double noise() { return (uniform() + uniform() + uniform() + uniform() - 2.0) * 1.732; }
+};
+
+struct Segment {
+  int minutes;
+  int people;
+  double ach;
+};
+
+/**
+ * - Run a script against the bound
+ * - volume_m3 : volume given to the estimator (zone is 120 m³)
+ * - tell      : pass ACH changes on through setVentilation()
+ * - return    : true if every segment met the bound
+ */
+static bool run(const char *label, const Segment *seg, int n, uint8_t shift, uint32_t period_s, uint16_t volume_m3,
+                bool tell) {
+  Zone z;
+  z.ach = seg[0].ach;
+  SCD4x_Occupancy_7Semi est(volume_m3, (uint16_t)lround(z.ach * 100), 420);
+  est.setFilterShift(shift);
+  double assumedAch = z.ach;
+  // Start at the first segment's equilibrium
+  z.co2 = 420.0 + seg[0].people * 312.0 / 60.0 * 3600.0 / (z.volume * z.ach);
+
+  printf("%s\n", label);
+  printf("  %6s %5s %5s %5s %9s %7s %6s\n", "minute", "true", "ACH", "k", "settle", "mean", "rms");
+  uint32_t t = 0;
+  int minute = 0;
+  bool ok = true;
+  for (int i = 0; i < n; ++i) {
+    z.ach = seg[i].ach;
+    if (tell) {
+      assumedAch = z.ach;
+      est.setVentilation((uint16_t)lround(z.ach * 100));
+    }
+    const double k = (volume_m3 * assumedAch) / (z.volume * z.ach);
+    const double m = fabs(k - 1.0) * seg[i].people;
+    const uint32_t steps = (uint32_t)seg[i].minutes * 60 / period_s;
+    const uint32_t settleSteps = SETTLE_MIN * 60 / period_s;
+    uint32_t settled = 0;
+    double sum = 0, sq = 0;
+    uint32_t cnt = 0;
+    for (uint32_t j = 1; j <= steps; ++j) {
+      est.update(z.step(seg[i].people, period_s), t);
+      t += period_s * 1000;
+      const double e = est.occupancyQ8() / 256.0 - seg[i].people;
+      if (!settled && fabs(e) <= BOUND_MEAN + m) settled = j;
+      if (j > settleSteps) {
+        sum += e;
+        sq += e * e;
+        ++cnt;
+      }
+    }
+    const double mean = cnt ? sum / cnt : 0, rms = cnt ? sqrt(sq / cnt) : 0;
+    const double settle = (settled ? settled : steps) * period_s / 60.0;
+    const bool segOk =
+      settled && settled <= settleSteps && fabs(mean) <= BOUND_MEAN + m && rms <= BOUND_RMS + m;
+    ok &= segOk;
+    printf("  %6d %5d %5.1f %5.2f %6.1f min %+7.2f %6.2f%s\n", minute, seg[i].people, seg[i].ach, k, settle, mean,
+           rms, segOk ? "" : "  BOUND EXCEEDED");
+    minute += seg[i].minutes;
+  }
+  printf("\n");
+  return ok;
+}
+
+/** - Mean absolute error over an office week (random head count every 30 min) */
+static void office(uint8_t shift, uint32_t period_s) {
+  Scd4xOfficeSim sim(42, period_s * 1000, 120.0, 1.2, 8);
+  SCD4x_Occupancy_7Semi est(120, 120, 420);
+  est.setFilterShift(shift);
+  const uint32_t n = 7UL * 86400 / period_s;
+  double abs = 0, absOcc = 0;
+  uint32_t occ = 0;
+  for (uint32_t i = 0; i < n; ++i) {
+    const Scd4xSimSample s = sim.next();
+    est.update(s.co2_ppm, s.t_ms);
+    const double e = fabs(est.occupancyQ8() / 256.0 - s.people);
+    abs += e;
+    if (s.people) {
+      absOcc += e;
+      ++occ;
+    }
+  }
+  printf("office week: MAE %.2f persons overall, %.2f while occupied (lag after each change included)\n",
+         abs / n, occ ? absOcc / occ : 0.0);
+}
+
+int main(int argc, char **argv) {
+  const uint8_t shift = (argc > 1) ? (uint8_t)atoi(argv[1]) : 4;
+  const uint32_t period = (argc > 2) ? (uint32_t)atoi(argv[2]) : 5;
+  printf("shift %u, %lu s samples, 120 m3, bound: within %.1f + m by %d min, then |mean| <= %.1f + m, "
+         "rms <= %.1f + m (m = |k - 1| x true)\n\n",
+         shift, (unsigned long)period, BOUND_MEAN, SETTLE_MIN, BOUND_MEAN, BOUND_RMS);
+
+  const Segment steps[] = {
+    { 60, 0, 1.2 },   // empty
+    { 120, 6, 1.2 },  // step in
+    { 120, 0, 1.2 },  // step out
+    { 120, 3, 1.2 },
+    { 60, 8, 1.2 },
+    { 60, 2, 1.2 },
+  };
+  const Segment vent[] = {
+    { 120, 3, 1.2 },
+    { 120, 3, 4.0 },  // window opened
+    { 120, 3, 1.2 },
+    { 120, 5, 0.6 },  // ventilation turned down
+  };
+  const int ns = sizeof(steps) / sizeof(steps[0]), nv = sizeof(vent) / sizeof(vent[0]);
+  bool ok = run("step in / step out", steps, ns, shift, period, 120, true);
+  ok &= run("ventilation change", vent, nv, shift, period, 120, true);
+  ok &= run("mismatch: volume set 20 % low (96 m3)", steps, ns, shift, period, 96, true);
+  ok &= run("mismatch: ventilation change not passed on", vent, nv, shift, period, 120, false);
+  office(shift, period);
+  return ok ? 0 : 1;
+}
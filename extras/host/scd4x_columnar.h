@@ -0,0 +1,391 @@
+#ifndef _7Semi_SCD4X_COLUMNAR_H
+#define _7Semi_SCD4X_COLUMNAR_H
+
+/**
+ * scd4x_columnar.h
+ * ----------------
+ * Host-only columnar (SoA) layout for SCD4x sample logs
+ *
+ * File layout (little-endian)
+ * ---------------------------
+ *   [0..63]    file header  : magic "S4CF", version, serial, variant,
+ *                             period, chunk rows, total rows, chunk count,
+ *                             directory offset
+ *   chunks     per chunk, per column, one region aligned to 64 bytes:
+ *                time : u16 Δt from the previous row (DELTA16), or u32
+ *                       offsets from the chunk's base key (ms)
+ *                co2  : u16 raw words, or u8 + base (FOR8)
+ *                t    : u16 raw words, or u8 + base
+ *                rh   : u16 raw words, or u8 + base
+ *   directory  one Scd4xColumnChunk per chunk (at the directory offset)
+ *
+ * Encoding
+ * --------
+ * - Time key = (epoch << 32) | t_ms as in the sample log zone maps; a chunk
+ *   is closed early if its span would not fit 32-bit offsets. Periodic
+ *   sampling always fits DELTA16 (Δt < 65.5 s), expanded by a prefix sum.
+ * - Value columns use FOR8 (frame of reference, 1 byte per row) when the
+ *   chunk's max − min < 256, else plain u16. Both are fixed width, so a
+ *   plain column is returned straight from the mapping and a FOR8 column
+ *   expands with one pass that compilers vectorize.
+ * - Min / max per column are kept in the directory (chunk pruning).
+ *
+ * Kernels
+ * -------
+ * - Scd4xColumnKernels: branch-free loops over aligned spans (sum, min/max,
+ *   count ≥ threshold, raw → °C / %RH). Build with -O3 (-march=native) and
+ *   the compiler emits SIMD for them; there is no intrinsic code here.
+ */
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "7Semi_SCD4x_Log.h"
+
+#define SCD4X_COL_MAGIC      "S4CF"
+#define SCD4X_COL_VERSION    1
+#define SCD4X_COL_ALIGN      64
+#define SCD4X_COL_HEADER_LEN 64
+#define SCD4X_COL_ENC_PLAIN  0
+#define SCD4X_COL_ENC_FOR8   1
+#define SCD4X_COL_ENC_DELTA16 2
+#define SCD4X_COL_CHUNK_ROWS 4096   // default rows per chunk
+
+/** - Value columns (time is separate) */
+enum Scd4xColumn : uint8_t { SCD4X_COL_CO2 = 0, SCD4X_COL_T = 1, SCD4X_COL_RH = 2 };
+
+/** - Directory entry (fixed 64 bytes on disk, host byte order = LE) */
+struct Scd4xColumnChunk {
+  uint64_t baseKey;        // time key of row 0
+  uint64_t timeOffset;     // file offset of the u32 time column
+  uint64_t valOffset[3];   // file offsets of the value columns
+  uint32_t rows;
+  uint8_t  enc[3];         // SCD4X_COL_ENC_PLAIN / FOR8
+  uint8_t  timeEnc;        // SCD4X_COL_ENC_PLAIN / DELTA16
+  uint16_t base[3];        // FOR8 base (= min)
+  uint16_t max[3];
+};
+static_assert(sizeof(Scd4xColumnChunk) == 64, "directory entry must stay 64 bytes");
+
+/** - Header as stored in bytes [0, 64) */
+struct Scd4xColumnHeader {
+  char     magic[4];
+  uint16_t version;
+  uint16_t variant;
+  uint64_t serial;
+  uint32_t periodMs;
+  uint32_t chunkRows;
+  uint64_t rows;
+  uint64_t dirOffset;
+  uint32_t chunks;
+  uint8_t  reserved[20];
+};
+static_assert(sizeof(Scd4xColumnHeader) == SCD4X_COL_HEADER_LEN, "header must stay 64 bytes");
+
+// ======================= Writer =======================
+
+class Scd4xColumnWriter {
+public:
+  /**
+   * - chunk_rows : rows per chunk; 4096 keeps a u16 column at 8 KB (L1) and
+   *   lets FOR8 apply to slow channels
+   */
+  explicit Scd4xColumnWriter(uint32_t chunk_rows = SCD4X_COL_CHUNK_ROWS)
+    : chunkRows(chunk_rows ? chunk_rows : SCD4X_COL_CHUNK_ROWS) {}
+  ~Scd4xColumnWriter() { if (f) fclose(f); }
+
+  /** - Create the output file; info supplies serial / variant / period */
+  bool open(const char *path, const SCD4x_LogInfo_7Semi &info) {
+    f = fopen(path, "wb");
+    if (!f) return false;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, SCD4X_COL_MAGIC, 4);
+    hdr.version = SCD4X_COL_VERSION;
+    hdr.variant = info.variant;
+    hdr.serial = info.serial;
+    hdr.periodMs = info.periodMs;
+    hdr.chunkRows = chunkRows;
+    pos = 0;
+    ok = true;
+    return put(&hdr, sizeof(hdr));
+  }
+
+  /** - Append one row (key as delivered by Scd4xLogReader) */
+  void add(uint64_t key, const SCD4x_RawSample_7Semi &s) {
+    if (!t.empty() && (t.size() >= chunkRows || key - base > 0xFFFFFFFFULL || key < base)) flushChunk();
+    if (t.empty()) base = key;
+    t.push_back((uint32_t)(key - base));
+    v[0].push_back(s.co2_raw);
+    v[1].push_back(s.t_raw);
+    v[2].push_back(s.rh_raw);
+  }
+
+  /** - Write pending rows, directory and final header */
+  bool close() {
+    if (!f) return false;
+    if (!t.empty()) flushChunk();
+    align();
+    hdr.dirOffset = pos;
+    hdr.chunks = (uint32_t)dir.size();
+    if (!dir.empty()) put(dir.data(), dir.size() * sizeof(Scd4xColumnChunk));
+    ok = ok && fseek(f, 0, SEEK_SET) == 0 && fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+    ok = (fclose(f) == 0) && ok;
+    f = nullptr;
+    return ok;
+  }
+
+  uint64_t rows() const { return hdr.rows + t.size(); }
+  uint64_t bytes() const { return pos; }
+
+private:
+  FILE *f = nullptr;
+  uint32_t chunkRows;
+  Scd4xColumnHeader hdr;
+  uint64_t pos = 0;
+  bool ok = false;
+  uint64_t base = 0;
+  std::vector<uint32_t> t;
+  std::vector<uint16_t> v[3];
+  std::vector<uint16_t> step;
+  std::vector<uint8_t> narrow;
+  std::vector<Scd4xColumnChunk> dir;
+
+  bool put(const void *p, size_t n) {
+    if (n && fwrite(p, 1, n, f) != n) ok = false;
+    pos += n;
+    return ok;
+  }
+
+  void align() {
+    static const uint8_t zero[SCD4X_COL_ALIGN] = { 0 };
+    const size_t pad = (size_t)(-pos & (SCD4X_COL_ALIGN - 1));
+    put(zero, pad);
+  }
+
+  void flushChunk() {
+    Scd4xColumnChunk c;
+    memset(&c, 0, sizeof(c));
+    c.baseKey = base;
+    c.rows = (uint32_t)t.size();
+
+    align();
+    c.timeOffset = pos;
+    uint32_t maxStep = 0;
+    for (size_t i = 1; i < t.size(); ++i)
+      if (t[i] - t[i - 1] > maxStep) maxStep = t[i] - t[i - 1];
+    if (maxStep <= 0xFFFF) {
+      c.timeEnc = SCD4X_COL_ENC_DELTA16;
+      step.resize(t.size());
+      step[0] = 0;
+      for (size_t i = 1; i < t.size(); ++i) step[i] = (uint16_t)(t[i] - t[i - 1]);
+      put(step.data(), step.size() * sizeof(uint16_t));
+    } else {
+      c.timeEnc = SCD4X_COL_ENC_PLAIN;
+      put(t.data(), t.size() * sizeof(uint32_t));
+    }
+
+    for (int k = 0; k < 3; ++k) {
+      uint16_t lo = 0xFFFF, hi = 0;
+      for (uint16_t x : v[k]) {
+        lo = x < lo ? x : lo;
+        hi = x > hi ? x : hi;
+      }
+      c.base[k] = lo;
+      c.max[k] = hi;
+      align();
+      c.valOffset[k] = pos;
+      if (hi - lo < 256) {
+        c.enc[k] = SCD4X_COL_ENC_FOR8;
+        narrow.resize(v[k].size());
+        for (size_t i = 0; i < v[k].size(); ++i) narrow[i] = (uint8_t)(v[k][i] - lo);
+        put(narrow.data(), narrow.size());
+      } else {
+        c.enc[k] = SCD4X_COL_ENC_PLAIN;
+        put(v[k].data(), v[k].size() * sizeof(uint16_t));
+      }
+      v[k].clear();
+    }
+    hdr.rows += t.size();
+    t.clear();
+    dir.push_back(c);
+  }
+};
+
+// ======================= Reader =======================
+
+class Scd4xColumnReader {
+public:
+  Scd4xColumnReader() {}
+  ~Scd4xColumnReader() { close(); }
+  Scd4xColumnReader(const Scd4xColumnReader &) = delete;
+  Scd4xColumnReader &operator=(const Scd4xColumnReader &) = delete;
+
+  /**
+   * - Map a columnar file; false on bad magic / version / bounds
+   * - Every chunk's rows, encodings and column regions are checked against
+   *   the header and the mapping here, so time() / values() need no checks
+   */
+  bool open(const char *path) {
+    close();
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < SCD4X_COL_HEADER_LEN) {
+      ::close(fd);
+      return false;
+    }
+    len = (size_t)st.st_size;
+    void *m = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (m == MAP_FAILED) {
+      len = 0;
+      return false;
+    }
+    base = (const uint8_t *)m;
+    memcpy(&hdr, base, sizeof(hdr));
+    if (memcmp(hdr.magic, SCD4X_COL_MAGIC, 4) != 0 || hdr.version != SCD4X_COL_VERSION ||
+        !fits(hdr.dirOffset, (uint64_t)hdr.chunks * sizeof(Scd4xColumnChunk))) {
+      close();
+      return false;
+    }
+    dir = (const Scd4xColumnChunk *)(base + hdr.dirOffset);
+    uint64_t rows = 0;
+    for (uint32_t i = 0; i < hdr.chunks; ++i) {
+      if (!validChunk(dir[i])) {
+        close();
+        return false;
+      }
+      rows += dir[i].rows;
+    }
+    if (rows != hdr.rows) {
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  void close() {
+    if (base) munmap((void *)base, len);
+    base = nullptr;
+    len = 0;
+    dir = nullptr;
+  }
+
+  const Scd4xColumnHeader &header() const { return hdr; }
+  uint32_t chunkCount() const { return base ? hdr.chunks : 0; }
+  const Scd4xColumnChunk &chunk(uint32_t i) const { return dir[i]; }
+
+  /**
+   * - Time offsets of chunk i (ms from chunk(i).baseKey), 64-byte aligned
+   * - PLAIN points into the mapping; DELTA16 is prefix-summed into scratch
+   */
+  const uint32_t *time(uint32_t i, uint32_t *scratch) const {
+    const Scd4xColumnChunk &c = dir[i];
+    if (c.timeEnc == SCD4X_COL_ENC_PLAIN) return (const uint32_t *)(base + c.timeOffset);
+    const uint16_t *d = (const uint16_t *)(base + c.timeOffset);
+    uint32_t acc = 0;
+    for (uint32_t k = 0; k < c.rows; ++k) scratch[k] = acc += d[k];
+    return scratch;
+  }
+
+  /**
+   * - Value column of chunk i as u16, 64-byte aligned
+   * - Plain columns point into the mapping; FOR8 columns are expanded into
+   *   scratch (chunkRows entries, caller-owned, 64-byte aligned)
+   */
+  const uint16_t *values(uint32_t i, Scd4xColumn col, uint16_t *scratch) const {
+    const Scd4xColumnChunk &c = dir[i];
+    const uint8_t *p = base + c.valOffset[col];
+    if (c.enc[col] == SCD4X_COL_ENC_PLAIN) return (const uint16_t *)p;
+    const uint16_t b = c.base[col];
+    for (uint32_t k = 0; k < c.rows; ++k) scratch[k] = (uint16_t)(b + p[k]);
+    return scratch;
+  }
+
+private:
+  const uint8_t *base = nullptr;
+  size_t len = 0;
+  Scd4xColumnHeader hdr;
+  const Scd4xColumnChunk *dir = nullptr;
+
+  /** - [off, off + n) lies inside the mapping and off is column-aligned */
+  bool fits(uint64_t off, uint64_t n) const {
+    return (off % SCD4X_COL_ALIGN) == 0 && off >= SCD4X_COL_HEADER_LEN && off <= len && n <= len - off;
+  }
+
+  /** - Rows within the scratch size, known encodings, columns inside the file */
+  bool validChunk(const Scd4xColumnChunk &c) const {
+    if (c.rows == 0 || c.rows > hdr.chunkRows) return false;
+    uint64_t tw;
+    if (c.timeEnc == SCD4X_COL_ENC_DELTA16) tw = 2;
+    else if (c.timeEnc == SCD4X_COL_ENC_PLAIN) tw = 4;
+    else return false;
+    if (!fits(c.timeOffset, tw * c.rows)) return false;
+    for (int k = 0; k < 3; ++k) {
+      uint64_t w;
+      if (c.enc[k] == SCD4X_COL_ENC_FOR8) w = 1;
+      else if (c.enc[k] == SCD4X_COL_ENC_PLAIN) w = 2;
+      else return false;
+      if (!fits(c.valOffset[k], w * c.rows)) return false;
+    }
+    return true;
+  }
+};
+
+// ======================= Kernels =======================
+
+struct Scd4xColumnKernels {
+  static uint64_t sum(const uint16_t *__restrict v, size_t n) {
+    uint64_t s = 0;
+    for (size_t i = 0; i < n; ++i) s += v[i];
+    return s;
+  }
+
+  static void minMax(const uint16_t *__restrict v, size_t n, uint16_t &lo, uint16_t &hi) {
+    uint16_t a = 0xFFFF, b = 0;
+    for (size_t i = 0; i < n; ++i) {
+      a = v[i] < a ? v[i] : a;
+      b = v[i] > b ? v[i] : b;
+    }
+    lo = a;
+    hi = b;
+  }
+
+  static size_t countAtLeast(const uint16_t *__restrict v, size_t n, uint16_t thr) {
+    size_t c = 0;
+    for (size_t i = 0; i < n; ++i) c += v[i] >= thr;
+    return c;
+  }
+
+  /** - °C = −45 + 175 · raw / 65535 */
+  static void tempC(const uint16_t *__restrict raw, float *__restrict out, size_t n) {
+    const float k = 175.0f / 65535.0f;
+    for (size_t i = 0; i < n; ++i) out[i] = -45.0f + k * (float)raw[i];
+  }
+
+  /** - %RH = 100 · raw / 65535 */
+  static void rhPercent(const uint16_t *__restrict raw, float *__restrict out, size_t n) {
+    const float k = 100.0f / 65535.0f;
+    for (size_t i = 0; i < n; ++i) out[i] = k * (float)raw[i];
+  }
+
+  static double sumF(const float *__restrict v, size_t n) {
+    float s[8] = { 0 };  // 8 lanes keep the reduction vectorizable without -ffast-math
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+      for (int l = 0; l < 8; ++l) s[l] += v[i + l];
+    double t = 0;
+    for (int l = 0; l < 8; ++l) t += s[l];
+    for (; i < n; ++i) t += v[i];
+    return t;
+  }
+};
+
+#endif  // _7Semi_SCD4X_COLUMNAR_H
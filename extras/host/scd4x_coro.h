@@ -0,0 +1,420 @@
+#ifndef _7Semi_SCD4X_CORO_H
+#define _7Semi_SCD4X_CORO_H
+
+/**
+ * scd4x_coro.h
+ * ------------
+ * Host-only C++20 coroutine API: write acquisition sequentially with
+ * `co_await sensor.readMeasurement()` while one thread drives hundreds of
+ * sensors
+ *
+ * Classes
+ * -------
+ * - Scd4xCoLoop   : single-thread timer loop; resumes coroutines when the
+ *                   command execution time (or a sleep) has elapsed
+ * - Scd4xCoTask   : fire-and-forget coroutine started with loop.spawn()
+ * - Scd4xCoSensor : split-phase commands as awaitables over Scd4xI2cPort
+ *                   (readMeasurement, getDataReadyStatus, forced
+ *                   recalibration, self-test, start / stop, serial,
+ *                   variant, setting getters / setters, persist)
+ *
+ * Model
+ * -----
+ * - An awaitable writes the command in await_suspend(), parks the
+ *   coroutine on a timer for the command's execution time, and reads and
+ *   CRC-checks the response in await_resume() when the loop resumes it.
+ *   A failed write resumes immediately with ok = false.
+ * - Awaitables are plain structs living in the awaiting coroutine's frame
+ *   and carry their own timer node; the loop's heap and task table are
+ *   vectors reserved up front, and a finished task is swap-removed from
+ *   the table in O(1). So an await performs no heap allocation — only each
+ *   task's frame is allocated, once, when it is spawned.
+ *
+ * Notes
+ * -----
+ * - Transfers themselves are synchronous kernel calls (a few hundred µs at
+ *   100 kHz); what the coroutines avoid is sleeping through the 1 ms …
+ *   10 s execution times, which dominate.
+ * - Execution times follow the datasheet (forced recalibration 400 ms;
+ *   the blocking driver waits 500 ms).
+ * - Not thread-safe: loop, sensors and tasks belong to one thread.
+ */
+
+#include <stdint.h>
+#include <time.h>
+
+#include <algorithm>
+#include <coroutine>
+#include <exception>
+#include <vector>
+
+#include "scd4x_crc_bulk.h"
+#include "scd4x_i2c_bus.h"
+
+class Scd4xCoLoop;
+
+/** - Intrusive timer node (embedded in awaitables and task promises) */
+struct Scd4xCoTimer {
+  uint64_t due = 0;  // mono µs
+  uint64_t seq = 0;  // FIFO among equal deadlines
+  std::coroutine_handle<> h;
+};
+
+// ======================= Task =======================
+
+class Scd4xCoTask {
+public:
+  struct promise_type {
+    Scd4xCoLoop *loop = nullptr;
+    Scd4xCoTimer start;
+    size_t slot = 0;  // index in the loop's task table
+
+    Scd4xCoTask get_return_object() {
+      return Scd4xCoTask(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    struct Final {
+      bool await_ready() noexcept { return false; }
+      void await_suspend(std::coroutine_handle<promise_type> h) noexcept;
+      void await_resume() noexcept {}
+    };
+    Final final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  Scd4xCoTask(Scd4xCoTask &&o) noexcept : h(o.h) { o.h = nullptr; }
+  Scd4xCoTask(const Scd4xCoTask &) = delete;
+  ~Scd4xCoTask() {
+    if (h) h.destroy();
+  }
+
+private:
+  friend class Scd4xCoLoop;
+  explicit Scd4xCoTask(std::coroutine_handle<promise_type> c) : h(c) {}
+  std::coroutine_handle<promise_type> h;
+};
+
+// ======================= Loop =======================
+
+class Scd4xCoLoop {
+public:
+  /**
+   * - max_timers : pending timers and live tasks without reallocation
+   */
+  explicit Scd4xCoLoop(size_t max_timers = 1024) {
+    heap.reserve(max_timers);
+    tasks.reserve(max_timers);
+  }
+  ~Scd4xCoLoop() {
+    for (auto h : tasks) h.destroy();
+  }
+
+  /** - Take ownership of a task and start it on the next run / runDue */
+  void spawn(Scd4xCoTask t) {
+    auto h = t.h;
+    t.h = nullptr;
+    h.promise().loop = this;
+    h.promise().start.h = h;
+    h.promise().slot = tasks.size();
+    tasks.push_back(h);
+    at(h.promise().start, scd4xMonoUs());
+  }
+
+  /** - Park a timer node; its coroutine is resumed at t.due */
+  void at(Scd4xCoTimer &t, uint64_t due_us) {
+    t.due = due_us;
+    t.seq = seq++;
+    heap.push_back(&t);
+    std::push_heap(heap.begin(), heap.end(), later);
+  }
+
+  /** - Earliest pending deadline (UINT64_MAX when idle) */
+  uint64_t nextDue() const { return heap.empty() ? UINT64_MAX : heap.front()->due; }
+
+  /**
+   * - Resume every coroutine due at or before now (for embedding in an
+   *   existing epoll / timerfd loop)
+   * - return : coroutines resumed
+   */
+  size_t runDue(uint64_t now_us) {
+    size_t n = 0;
+    while (!heap.empty() && heap.front()->due <= now_us) {
+      std::pop_heap(heap.begin(), heap.end(), later);
+      Scd4xCoTimer *t = heap.back();
+      heap.pop_back();
+      if (now_us - t->due > maxLag) maxLag = now_us - t->due;
+      ++n;
+      ++nResumes;
+      t->h.resume();
+    }
+    return n;
+  }
+
+  /** - Run until every task finished or stop() (sleeps between deadlines) */
+  void run() {
+    running = true;
+    while (running && !tasks.empty()) {
+      const uint64_t due = nextDue();
+      if (due == UINT64_MAX) break;  // tasks alive but nothing scheduled
+      struct timespec ts = { (time_t)(due / 1000000ULL), (long)(due % 1000000ULL) * 1000 };
+      clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+      runDue(scd4xMonoUs());
+    }
+  }
+  void stop() { running = false; }
+
+  size_t liveTasks() const { return tasks.size(); }
+  uint64_t resumes() const { return nResumes; }
+  /** - Largest resume delay past a deadline seen so far (µs) */
+  uint64_t maxLagUs() const { return maxLag; }
+
+  // ---- sleeping ----
+
+  struct Sleep {
+    Scd4xCoLoop *loop;
+    uint64_t due;
+    Scd4xCoTimer t;
+    bool await_ready() const noexcept { return due <= scd4xMonoUs(); }
+    void await_suspend(std::coroutine_handle<> h) {
+      t.h = h;
+      loop->at(t, due);
+    }
+    void await_resume() const noexcept {}
+  };
+  /** - co_await loop.sleepUntil(mono_us) */
+  Sleep sleepUntil(uint64_t mono_us) { return Sleep{ this, mono_us, {} }; }
+  /** - co_await loop.sleepFor(us) */
+  Sleep sleepFor(uint64_t us) { return Sleep{ this, scd4xMonoUs() + us, {} }; }
+
+private:
+  friend struct Scd4xCoTask::promise_type::Final;
+
+  std::vector<Scd4xCoTimer *> heap;
+  std::vector<std::coroutine_handle<Scd4xCoTask::promise_type>> tasks;
+  uint64_t seq = 0, nResumes = 0, maxLag = 0;
+  bool running = false;
+
+  static bool later(const Scd4xCoTimer *a, const Scd4xCoTimer *b) {
+    return a->due != b->due ? a->due > b->due : a->seq > b->seq;
+  }
+
+  /** - Swap-remove h from the task table and destroy its frame */
+  void finished(std::coroutine_handle<Scd4xCoTask::promise_type> h) {
+    const size_t i = h.promise().slot;
+    tasks[i] = tasks.back();
+    tasks[i].promise().slot = i;
+    tasks.pop_back();
+    // Suspended at final_suspend: safe to destroy here
+    h.destroy();
+  }
+};
+
+inline void Scd4xCoTask::promise_type::Final::await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+  h.promise().loop->finished(h);
+}
+
+// ======================= Results =======================
+
+struct Scd4xCoMeasurement {
+  bool ok;
+  uint16_t co2_ppm;
+  float temp_c, rh_percent;
+  uint16_t t_raw, rh_raw;
+};
+
+struct Scd4xCoStatus {
+  bool ok;
+  bool ready;    // low 11 bits non-zero
+  uint16_t raw;
+};
+
+struct Scd4xCoFrc {
+  bool ok;              // false also when the sensor reports 0xFFFF (FRC failed)
+  int16_t correction;   // ppm (raw − 0x8000)
+  uint16_t raw;
+};
+
+struct Scd4xCoSelfTest {
+  bool ok;
+  bool passed;   // raw == 0
+  uint16_t raw;
+};
+
+struct Scd4xCoSerial {
+  bool ok;
+  uint64_t serial;
+};
+
+struct Scd4xCoWord {
+  bool ok;
+  uint16_t value;
+};
+
+// ======================= Sensor =======================
+
+class Scd4xCoSensor {
+public:
+  Scd4xCoSensor(Scd4xCoLoop &loop, const Scd4xI2cPort &port, uint8_t address = 0x62)
+    : lp(&loop), port(port), address(address) {}
+
+  Scd4xCoLoop &loop() { return *lp; }
+
+  /**
+   * - One split-phase command: write (cmd [+ arg + CRC]), wait exec µs,
+   *   read nwords words with CRC
+   */
+  struct Command {
+    Scd4xCoSensor *s;
+    uint16_t cmd;
+    bool hasArg;
+    uint16_t arg;
+    uint32_t execUs;
+    uint8_t nwords;
+    Scd4xCoTimer t;
+    bool wrote = false;
+    uint16_t w[3] = { 0, 0, 0 };
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> h) {
+      uint8_t b[5] = { (uint8_t)(cmd >> 8), (uint8_t)cmd, 0, 0, 0 };
+      size_t n = 2;
+      if (hasArg) {
+        b[2] = (uint8_t)(arg >> 8);
+        b[3] = (uint8_t)arg;
+        b[4] = Scd4xCrcBulk::crc8(b[2], b[3]);
+        n = 5;
+      }
+      wrote = s->port.write(s->address, b, n);
+      if (!wrote || execUs == 0) return false;  // resume at once
+      t.h = h;
+      s->lp->at(t, scd4xMonoUs() + execUs);
+      return true;
+    }
+    /** - Read and CRC-check the response; false on any failure */
+    bool finish() {
+      if (!wrote) return false;
+      if (!nwords) return true;
+      uint8_t r[9];
+      if (!s->port.read(s->address, r, (size_t)nwords * 3)) return false;
+      for (uint8_t i = 0; i < nwords; ++i) {
+        const uint8_t *p = r + 3 * i;
+        if (Scd4xCrcBulk::crc8(p[0], p[1]) != p[2]) return false;
+        w[i] = (uint16_t)(p[0] << 8 | p[1]);
+      }
+      return true;
+    }
+    bool await_resume() { return finish(); }
+  };
+
+  struct Measure : Command {
+    Scd4xCoMeasurement await_resume() {
+      Scd4xCoMeasurement m = {};
+      m.ok = finish();
+      if (m.ok) {
+        m.co2_ppm = w[0];
+        m.t_raw = w[1];
+        m.rh_raw = w[2];
+        m.temp_c = -45.0f + 175.0f * (float)w[1] / 65535.0f;
+        m.rh_percent = 100.0f * (float)w[2] / 65535.0f;
+      }
+      return m;
+    }
+  };
+  struct Status : Command {
+    Scd4xCoStatus await_resume() {
+      Scd4xCoStatus r = {};
+      r.ok = finish();
+      r.raw = w[0];
+      r.ready = r.ok && (w[0] & 0x07FF) != 0;
+      return r;
+    }
+  };
+  struct Frc : Command {
+    Scd4xCoFrc await_resume() {
+      Scd4xCoFrc r = {};
+      r.ok = finish() && w[0] != 0xFFFF;
+      r.raw = w[0];
+      r.correction = (int16_t)((int32_t)w[0] - 0x8000);
+      return r;
+    }
+  };
+  struct SelfTest : Command {
+    Scd4xCoSelfTest await_resume() {
+      Scd4xCoSelfTest r = {};
+      r.ok = finish();
+      r.raw = w[0];
+      r.passed = r.ok && w[0] == 0;
+      return r;
+    }
+  };
+  struct Word : Command {
+    Scd4xCoWord await_resume() {
+      Scd4xCoWord r = {};
+      r.ok = finish();
+      r.value = w[0];
+      return r;
+    }
+  };
+  /** - wake_up: the sleeping sensor NACKs the write, so it is not checked */
+  struct Wake : Command {
+    bool await_suspend(std::coroutine_handle<> h) {
+      const uint8_t b[2] = { (uint8_t)(cmd >> 8), (uint8_t)cmd };
+      s->port.write(s->address, b, sizeof(b));
+      wrote = true;
+      t.h = h;
+      s->lp->at(t, scd4xMonoUs() + execUs);
+      return true;
+    }
+  };
+  struct Serial : Command {
+    Scd4xCoSerial await_resume() {
+      Scd4xCoSerial r = {};
+      r.ok = finish();
+      r.serial = ((uint64_t)w[0] << 32) | ((uint64_t)w[1] << 16) | w[2];
+      return r;
+    }
+  };
+
+  /** - co_await → Scd4xCoMeasurement (1 ms) */
+  Measure readMeasurement() { return Measure{ { this, 0xEC05, false, 0, 1000, 3, {} } }; }
+  /** - co_await → Scd4xCoStatus (1 ms) */
+  Status getDataReadyStatus() { return Status{ { this, 0xE4B8, false, 0, 1000, 1, {} } }; }
+  /** - co_await → Scd4xCoFrc (400 ms); sensor must be idle */
+  Frc performForcedRecalibration(uint16_t reference_ppm) {
+    return Frc{ { this, 0x362F, true, reference_ppm, 400000, 1, {} } };
+  }
+  /** - co_await → Scd4xCoSelfTest (10 s); sensor must be idle */
+  SelfTest performSelfTest() { return SelfTest{ { this, 0x3639, false, 0, 10000000, 1, {} } }; }
+  /** - co_await → Scd4xCoSerial (1 ms) */
+  Serial readSerialNumber() { return Serial{ { this, 0x3682, false, 0, 1000, 3, {} } }; }
+  /** - co_await → bool; no wait (first sample one period later) */
+  Command startPeriodicMeasurement() { return Command{ this, 0x21B1, false, 0, 0, 0, {} }; }
+  /** - co_await → bool; 500 ms until the sensor accepts other commands */
+  Command stopPeriodicMeasurement() { return Command{ this, 0x3F86, false, 0, 500000, 0, {} }; }
+  /**
+   * - co_await → bool (always true); a sleeping sensor does not ACK, so
+   *   this waits 30 ms regardless; confirm with e.g. readSerialNumber()
+   */
+  Wake wakeUp() { return Wake{ { this, 0x36F6, false, 0, 30000, 0, {} } }; }
+  /** - co_await → bool; no wait (first sample ~30 s later) */
+  Command startLowPowerPeriodicMeasurement() { return Command{ this, 0x21AC, false, 0, 0, 0, {} }; }
+  /** - co_await → Scd4xCoWord (1 ms) */
+  Word getSensorVariantRaw() { return Word{ { this, 0x202F, false, 0, 1000, 1, {} } }; }
+  /** - co_await → bool (800 ms NVM write); sensor must be idle */
+  Command persistSettings() { return Command{ this, 0x3615, false, 0, 800000, 0, {} }; }
+
+  /**
+   * - Any one-word getter / setter (1 ms), e.g. 0x2318 / 0x241D for the
+   *   temperature offset; sensor must be idle except for ambient pressure
+   */
+  Word getWord(uint16_t cmd) { return Word{ { this, cmd, false, 0, 1000, 1, {} } }; }
+  Command setWord(uint16_t cmd, uint16_t value) { return Command{ this, cmd, true, value, 1000, 0, {} }; }
+
+private:
+  Scd4xCoLoop *lp;
+  Scd4xI2cPort port;
+  uint8_t address;
+};
+
+#endif  // _7Semi_SCD4X_CORO_H
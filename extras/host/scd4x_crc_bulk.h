@@ -0,0 +1,188 @@
+#ifndef _7Semi_SCD4X_CRC_BULK_H
+#define _7Semi_SCD4X_CRC_BULK_H
+
+/**
+ * scd4x_crc_bulk.h
+ * ----------------
+ * Host-only bulk check of packed [MSB, LSB, CRC] words, as they appear on
+ * the wire and in raw bus captures
+ *
+ * Math
+ * ----
+ * - Sensirion CRC-8 (poly 0x31, init 0xFF) over two bytes is affine over
+ *   GF(2): crc(b0, b1) = S0[b0] ^ S1[b1], with S0 including the init term.
+ *   Two independent 256-byte lookups replace 16 shift/xor steps, and the
+ *   lookups of neighbouring words overlap (slicing-by-2, unrolled ×8).
+ * - Each table splits again by nibble: S(x) = lo[x & 15] ^ hi[x >> 4].
+ *   Sixteen-entry tables are exactly what PSHUFB looks up, so the SSSE3
+ *   path checks 16 words (48 bytes) per iteration: deinterleave with
+ *   PSHUFB, four nibble lookups, compare, movemask.
+ *
+ * Output
+ * ------
+ * - Bitmap: bit (i & 7) of byte i / 8 set → word i has a bad CRC.
+ * - Same verdict as SCD4x_7Semi::checkCrc() for every word.
+ *
+ * Notes
+ * -----
+ * - The SIMD path is compiled when __SSSE3__ is defined (-mssse3 or
+ *   -march=native); otherwise validate() uses the table path.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+struct Scd4xCrcBulk {
+  /** - Bitwise reference, identical to SCD4x_7Semi::crc8() */
+  static uint8_t crc8(uint8_t b0, uint8_t b1) {
+    uint8_t crc = 0xFF;
+    crc ^= b0;
+    for (int i = 0; i < 8; ++i) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    crc ^= b1;
+    for (int i = 0; i < 8; ++i) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    return crc;
+  }
+
+  /**
+   * - Per-word loop over crc8(): the baseline
+   * - return : bad words; bitmap needs (n + 7) / 8 bytes
+   */
+  static size_t validateReference(const uint8_t *w, size_t n, uint8_t *bad) {
+    memset(bad, 0, (n + 7) / 8);
+    size_t nBad = 0;
+    for (size_t i = 0; i < n; ++i, w += 3)
+      if (crc8(w[0], w[1]) != w[2]) {
+        bad[i >> 3] |= (uint8_t)(1 << (i & 7));
+        ++nBad;
+      }
+    return nBad;
+  }
+
+  /** - Slicing-by-2 table path */
+  static size_t validateTable(const uint8_t *w, size_t n, uint8_t *bad) {
+    const Tables &t = tables();
+    memset(bad, 0, (n + 7) / 8);
+    size_t nBad = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, w += 24) {
+      uint8_t m = 0;
+      for (int k = 0; k < 8; ++k)
+        m |= (uint8_t)((t.s0[w[3 * k]] ^ t.s1[w[3 * k + 1]] ^ w[3 * k + 2]) != 0) << k;
+      bad[i >> 3] = m;
+      nBad += popcount8(m);
+    }
+    for (; i < n; ++i, w += 3)
+      if (t.s0[w[0]] ^ t.s1[w[1]] ^ w[2]) {
+        bad[i >> 3] |= (uint8_t)(1 << (i & 7));
+        ++nBad;
+      }
+    return nBad;
+  }
+
+  /** - Fastest available path (SSSE3 when compiled in, else table) */
+  static size_t validate(const uint8_t *w, size_t n, uint8_t *bad) {
+#if defined(__SSSE3__)
+    const Tables &t = tables();
+    const __m128i a = _mm_loadu_si128((const __m128i *)t.n0lo);
+    const __m128i b = _mm_loadu_si128((const __m128i *)t.n0hi);
+    const __m128i c = _mm_loadu_si128((const __m128i *)t.n1lo);
+    const __m128i d = _mm_loadu_si128((const __m128i *)t.n1hi);
+    const __m128i nib = _mm_set1_epi8(0x0F);
+    const __m128i k = _mm_set1_epi8((char)t.k);
+
+    // Deinterleave masks: channel ch, source vector v → lane j takes 3j + ch − 16v
+    __m128i mask[3][3];
+    for (int ch = 0; ch < 3; ++ch)
+      for (int v = 0; v < 3; ++v) {
+        alignas(16) int8_t m[16];
+        for (int j = 0; j < 16; ++j) {
+          const int src = 3 * j + ch - 16 * v;
+          m[j] = (src >= 0 && src < 16) ? (int8_t)src : (int8_t)0x80;
+        }
+        mask[ch][v] = _mm_load_si128((const __m128i *)m);
+      }
+
+    size_t nBad = 0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16, w += 48) {
+      const __m128i v0 = _mm_loadu_si128((const __m128i *)w);
+      const __m128i v1 = _mm_loadu_si128((const __m128i *)(w + 16));
+      const __m128i v2 = _mm_loadu_si128((const __m128i *)(w + 32));
+      __m128i ch[3];
+      for (int c3 = 0; c3 < 3; ++c3)
+        ch[c3] = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, mask[c3][0]), _mm_shuffle_epi8(v1, mask[c3][1])),
+                              _mm_shuffle_epi8(v2, mask[c3][2]));
+      const __m128i b0lo = _mm_and_si128(ch[0], nib);
+      const __m128i b0hi = _mm_and_si128(_mm_srli_epi16(ch[0], 4), nib);
+      const __m128i b1lo = _mm_and_si128(ch[1], nib);
+      const __m128i b1hi = _mm_and_si128(_mm_srli_epi16(ch[1], 4), nib);
+      __m128i crc = _mm_xor_si128(_mm_shuffle_epi8(a, b0lo), _mm_shuffle_epi8(b, b0hi));
+      crc = _mm_xor_si128(crc, _mm_xor_si128(_mm_shuffle_epi8(c, b1lo), _mm_shuffle_epi8(d, b1hi)));
+      crc = _mm_xor_si128(crc, k);
+      const unsigned good = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(crc, ch[2]));
+      const unsigned m = ~good & 0xFFFF;
+      bad[i >> 3] = (uint8_t)m;
+      bad[(i >> 3) + 1] = (uint8_t)(m >> 8);
+      nBad += popcount8((uint8_t)m) + popcount8((uint8_t)(m >> 8));
+    }
+    return nBad + (i < n ? validateTable(w, n - i, bad + (i >> 3)) : 0);
+#else
+    return validateTable(w, n, bad);
+#endif
+  }
+
+  /** - Name of the path validate() uses */
+  static const char *path() {
+#if defined(__SSSE3__)
+    return "ssse3";
+#else
+    return "table";
+#endif
+  }
+
+private:
+  struct Tables {
+    uint8_t s0[256], s1[256];            // crc = s0[b0] ^ s1[b1]
+    uint8_t n0lo[16], n0hi[16];          // linear part of s0 by nibble
+    uint8_t n1lo[16], n1hi[16];          // s1 by nibble
+    uint8_t k;                           // crc(0, 0)
+  };
+
+  static const Tables &tables() {
+    static const Tables t = build();
+    return t;
+  }
+
+  static Tables build() {
+    Tables t;
+    t.k = crc8(0, 0);
+    for (int x = 0; x < 256; ++x) {
+      t.s0[x] = crc8((uint8_t)x, 0);
+      t.s1[x] = (uint8_t)(crc8(0, (uint8_t)x) ^ t.k);
+    }
+    for (int x = 0; x < 16; ++x) {
+      t.n0lo[x] = (uint8_t)(t.s0[x] ^ t.k);
+      t.n0hi[x] = (uint8_t)(t.s0[x << 4] ^ t.k);
+      t.n1lo[x] = t.s1[x];
+      t.n1hi[x] = t.s1[x << 4];
+    }
+    return t;
+  }
+
+  static unsigned popcount8(uint8_t m) {
+#if defined(__GNUC__)
+    return (unsigned)__builtin_popcount(m);
+#else
+    unsigned c = 0;
+    for (; m; m &= (uint8_t)(m - 1)) ++c;
+    return c;
+#endif
+  }
+};
+
+#endif  // _7Semi_SCD4X_CRC_BULK_H
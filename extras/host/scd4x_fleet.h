@@ -0,0 +1,407 @@
+#ifndef _7Semi_SCD4X_FLEET_H
+#define _7Semi_SCD4X_FLEET_H
+
+/**
+ * scd4x_fleet.h
+ * -------------
+ * Host-only fleet registry: discover SCD4x sensors on many buses / mux
+ * channels, key them by serial number and apply per-serial profiles
+ *
+ * Classes
+ * -------
+ * - Scd4xProfile       : settings a sensor should carry (temperature
+ *                        offset, altitude, ASC enable / target / periods),
+ *                        persist flag and the mode to leave it in
+ * - Scd4xProfileTable  : serial → profile, with a default; loads a small
+ *                        text file
+ * - Scd4xFleetRegistry : per-location discovery (wake, stop, serial,
+ *                        variant) and provisioning
+ *
+ * Scheduling
+ * ----------
+ * - Every bus gets its own thread running one Scd4xCoLoop; every location
+ *   on it is one coroutine. Execution times (stop 500 ms, persist 800 ms,
+ *   1 ms per getter / setter) overlap across all sensors of a bus, and
+ *   buses run in parallel, so commissioning time is one sensor's sequence
+ *   plus the transfer time of the busiest bus — not a sum over sensors.
+ * - A bus (and its mux) belongs to exactly one thread; Scd4xI2cPort
+ *   re-selects the mux channel before each transfer of another sensor.
+ *
+ * Provisioning
+ * ------------
+ * - Each pinned setting is read first and written only if it differs,
+ *   then read back. persist_settings runs only if something changed, so
+ *   re-provisioning an already commissioned fleet writes no NVM.
+ * - The same serial seen at two locations (mux not isolating channels) is
+ *   flagged; only its first location is provisioned.
+ *
+ * Profile file
+ * ------------
+ *   # serial (hex) or * for the default, then key=value pairs
+ *   *             altitude=120 asc=1 asc_target=420
+ *   0A1B2C3D4E5F  temp_offset=2.75 altitude=310 persist=1 start=periodic
+ *
+ *   keys : temp_offset (°C), altitude (m), asc (0/1), asc_target (ppm),
+ *          asc_initial (h), asc_standard (h), persist (0/1),
+ *          start (idle | periodic | low_power)
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "scd4x_coro.h"
+
+/** - Settings a profile can pin: key, get / set command */
+struct Scd4xSettingDef {
+  const char *key;
+  uint16_t get, set;
+};
+
+static const int SCD4X_PROFILE_SETTINGS = 6;
+static const Scd4xSettingDef SCD4X_SETTING_DEFS[SCD4X_PROFILE_SETTINGS] = {
+  { "temp_offset", 0x2318, 0x241D },   // word = °C · 65535 / 175
+  { "altitude", 0x2322, 0x2427 },      // m
+  { "asc", 0x2313, 0x2416 },           // 0 / 1
+  { "asc_target", 0x233F, 0x243A },    // ppm
+  { "asc_initial", 0x2340, 0x2445 },   // h
+  { "asc_standard", 0x234B, 0x244E },  // h
+};
+
+// ======================= Profiles =======================
+
+struct Scd4xProfile {
+  enum Start : uint8_t { IDLE = 0, PERIODIC, LOW_POWER };
+
+  uint8_t mask = 0;                              // bit i: setting i pinned
+  uint16_t value[SCD4X_PROFILE_SETTINGS] = {};   // raw words
+  bool persist = true;                           // persist_settings after changes
+  uint8_t start = IDLE;                          // mode after provisioning
+
+  void pin(int i, uint16_t v) {
+    mask |= (uint8_t)(1u << i);
+    value[i] = v;
+  }
+  bool pinned(int i) const { return mask & (1u << i); }
+
+  /** - Apply one key=value; false on unknown key or bad value */
+  bool parse(const char *key, const char *val) {
+    char *end = nullptr;
+    if (!strcmp(key, "persist")) {
+      persist = atoi(val) != 0;
+      return true;
+    }
+    if (!strcmp(key, "start")) {
+      if (!strcmp(val, "idle")) start = IDLE;
+      else if (!strcmp(val, "periodic")) start = PERIODIC;
+      else if (!strcmp(val, "low_power")) start = LOW_POWER;
+      else return false;
+      return true;
+    }
+    if (!strcmp(key, "temp_offset")) {
+      const double c = strtod(val, &end);
+      if (end == val || c < 0.0 || c > 175.0) return false;
+      pin(0, (uint16_t)(c * 65535.0 / 175.0 + 0.5));
+      return true;
+    }
+    for (int i = 1; i < SCD4X_PROFILE_SETTINGS; ++i) {
+      if (strcmp(key, SCD4X_SETTING_DEFS[i].key)) continue;
+      const unsigned long v = strtoul(val, &end, 0);
+      if (end == val || v > 0xFFFF) return false;
+      pin(i, (uint16_t)v);
+      return true;
+    }
+    return false;
+  }
+};
+
+class Scd4xProfileTable {
+public:
+  void setDefault(const Scd4xProfile &p) {
+    def = p;
+    hasDef = true;
+  }
+  void set(uint64_t serial, const Scd4xProfile &p) { bySerial[serial] = p; }
+
+  /**
+   * - Profile for serial: its own, else the default, else nullptr
+   * - exact : out true when the serial has its own entry
+   */
+  const Scd4xProfile *lookup(uint64_t serial, bool &exact) const {
+    auto it = bySerial.find(serial);
+    exact = it != bySerial.end();
+    if (exact) return &it->second;
+    return hasDef ? &def : nullptr;
+  }
+  size_t size() const { return bySerial.size() + (hasDef ? 1 : 0); }
+
+  /** - Parse "SERIAL|* key=value ..."; false with err set on a bad line */
+  bool parseLine(const std::string &line, std::string &err) {
+    std::vector<std::string> tok;
+    for (size_t p = 0; p < line.size();) {
+      while (p < line.size() && (line[p] == ' ' || line[p] == '\t' || line[p] == '\r')) ++p;
+      if (p >= line.size() || line[p] == '#') break;
+      size_t q = p;
+      while (q < line.size() && line[q] != ' ' && line[q] != '\t' && line[q] != '\r') ++q;
+      tok.push_back(line.substr(p, q - p));
+      p = q;
+    }
+    if (tok.empty()) return true;
+    Scd4xProfile prof;
+    for (size_t i = 1; i < tok.size(); ++i) {
+      const size_t eq = tok[i].find('=');
+      if (eq == std::string::npos || !prof.parse(tok[i].substr(0, eq).c_str(), tok[i].c_str() + eq + 1)) {
+        err = "bad setting '" + tok[i] + "'";
+        return false;
+      }
+    }
+    if (tok[0] == "*") {
+      setDefault(prof);
+      return true;
+    }
+    char *end = nullptr;
+    const uint64_t serial = strtoull(tok[0].c_str(), &end, 16);
+    if (*end || serial >> 48) {
+      err = "bad serial '" + tok[0] + "'";
+      return false;
+    }
+    set(serial, prof);
+    return true;
+  }
+
+  /** - Load a profile file; err names the failing line */
+  bool load(const char *path, std::string &err) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+      err = std::string("cannot open ") + path;
+      return false;
+    }
+    char buf[512];
+    int n = 0;
+    bool ok = true;
+    while (ok && fgets(buf, sizeof(buf), f)) {
+      ++n;
+      std::string line(buf);
+      if (!line.empty() && line.back() == '\n') line.pop_back();
+      std::string e;
+      if (!parseLine(line, e)) {
+        err = std::string(path) + ":" + std::to_string(n) + ": " + e;
+        ok = false;
+      }
+    }
+    fclose(f);
+    return ok;
+  }
+
+private:
+  std::unordered_map<uint64_t, Scd4xProfile> bySerial;
+  Scd4xProfile def;
+  bool hasDef = false;
+};
+
+// ======================= Registry =======================
+
+struct Scd4xFleetSensor {
+  enum State : uint8_t { ABSENT = 0, IDENTIFIED, PROVISIONED, FAILED };
+
+  Scd4xI2cPort port;
+  std::string where;        // "bus" or "bus:channel"
+  size_t bus = 0;           // index of the bus
+  uint8_t state = ABSENT;
+  uint64_t serial = 0;
+  uint16_t variant = 0;
+  bool duplicate = false;   // serial also seen at an earlier location
+  bool exactProfile = false;
+  uint8_t changed = 0;      // settings that differed (bit per setting)
+  bool persisted = false;
+  const char *error = "";
+  uint32_t provisionUs = 0;
+};
+
+class Scd4xFleetRegistry {
+public:
+  /**
+   * - Register a bus; mux_addr != 0 probes every channel in ch_mask,
+   *   otherwise the single 0x62 location
+   */
+  void addBus(Scd4xI2cBus *bus, uint8_t mux_addr = 0, uint8_t ch_mask = 0xFF) {
+    const size_t b = buses.size();
+    buses.push_back(bus);
+    for (int c = 0; c < 8; ++c) {
+      if (mux_addr && !(ch_mask & (1 << c))) continue;
+      Scd4xFleetSensor s;
+      s.port = Scd4xI2cPort(bus, mux_addr, c);
+      s.where = bus->name();
+      if (mux_addr) s.where += ":" + std::to_string(c);
+      s.bus = b;
+      all.push_back(s);
+      if (!mux_addr) break;
+    }
+  }
+
+  /**
+   * - Probe and identify every location (leaves sensors idle)
+   * - return : sensors found
+   */
+  size_t discover() {
+    index.clear();
+    for (Scd4xFleetSensor &s : all) {
+      const Scd4xI2cPort port = s.port;
+      const std::string where = s.where;
+      const size_t bus = s.bus;
+      s = Scd4xFleetSensor();
+      s.port = port;
+      s.where = where;
+      s.bus = bus;
+    }
+    perBus([](Scd4xCoSensor &c, Scd4xFleetSensor &s) { return identify(c, s); });
+
+    size_t found = 0;
+    for (size_t i = 0; i < all.size(); ++i) {
+      Scd4xFleetSensor &s = all[i];
+      if (s.state != Scd4xFleetSensor::IDENTIFIED) continue;
+      ++found;
+      auto it = index.find(s.serial);
+      if (it == index.end()) index[s.serial] = i;
+      else s.duplicate = true;
+    }
+    return found;
+  }
+
+  /**
+   * - Apply profiles to every identified, non-duplicate sensor
+   * - dry_run : only compare; report what would change
+   * - return  : sensors provisioned (including ones already up to date)
+   */
+  size_t provision(const Scd4xProfileTable &profiles, bool dry_run = false) {
+    perBus([&profiles, dry_run](Scd4xCoSensor &c, Scd4xFleetSensor &s) {
+      bool exact = false;
+      const Scd4xProfile *p = profiles.lookup(s.serial, exact);
+      s.exactProfile = exact;
+      return apply(c, s, p, dry_run);
+    });
+    size_t n = 0;
+    for (const Scd4xFleetSensor &s : all) n += s.state == Scd4xFleetSensor::PROVISIONED;
+    return n;
+  }
+
+  const std::vector<Scd4xFleetSensor> &sensors() const { return all; }
+  size_t busCount() const { return buses.size(); }
+
+  /** - Sensor by serial (first location), or nullptr */
+  const Scd4xFleetSensor *find(uint64_t serial) const {
+    auto it = index.find(serial);
+    return it == index.end() ? nullptr : &all[it->second];
+  }
+
+  /** - Wall time of the last discover() / provision() in seconds */
+  double lastRunS() const { return lastRun; }
+
+private:
+  std::vector<Scd4xI2cBus *> buses;
+  std::vector<Scd4xFleetSensor> all;
+  std::unordered_map<uint64_t, size_t> index;
+  double lastRun = 0.0;
+
+  /**
+   * - One thread + Scd4xCoLoop per bus; make(coSensor, entry) returns the
+   *   coroutine for each location of that bus
+   */
+  template <class F>
+  void perBus(F make) {
+    const uint64_t t0 = scd4xMonoUs();
+    std::vector<std::thread> th;
+    for (size_t b = 0; b < buses.size(); ++b) {
+      th.emplace_back([this, b, &make] {
+        std::vector<Scd4xFleetSensor *> mine;
+        for (Scd4xFleetSensor &s : all)
+          if (s.bus == b) mine.push_back(&s);
+        Scd4xCoLoop loop(mine.size() + 4);
+        std::vector<std::unique_ptr<Scd4xCoSensor>> co;
+        co.reserve(mine.size());
+        for (Scd4xFleetSensor *s : mine) {
+          co.emplace_back(new Scd4xCoSensor(loop, s->port));
+          loop.spawn(make(*co.back(), *s));
+        }
+        loop.run();
+      });
+    }
+    for (std::thread &t : th) t.join();
+    lastRun = (scd4xMonoUs() - t0) / 1e6;
+  }
+
+  static Scd4xCoTask identify(Scd4xCoSensor &c, Scd4xFleetSensor &s) {
+    co_await c.wakeUp();  // waits the 30 ms wake-up time itself
+    // stop is accepted in every state: a NACK means nothing is there
+    if (!co_await c.stopPeriodicMeasurement()) co_return;
+    const Scd4xCoSerial sn = co_await c.readSerialNumber();
+    if (!sn.ok) {
+      s.state = Scd4xFleetSensor::FAILED;
+      s.error = "serial read";
+      co_return;
+    }
+    s.serial = sn.serial;
+    const Scd4xCoWord v = co_await c.getSensorVariantRaw();
+    s.variant = v.ok ? v.value : 0;
+    s.state = Scd4xFleetSensor::IDENTIFIED;
+  }
+
+  static Scd4xCoTask apply(Scd4xCoSensor &c, Scd4xFleetSensor &s, const Scd4xProfile *p, bool dry_run) {
+    if (s.state != Scd4xFleetSensor::IDENTIFIED || s.duplicate) co_return;
+    const uint64_t t0 = scd4xMonoUs();
+    s.changed = 0;
+    s.persisted = false;
+    if (!p) {
+      s.state = Scd4xFleetSensor::FAILED;
+      s.error = "no profile";
+      co_return;
+    }
+    for (int i = 0; i < SCD4X_PROFILE_SETTINGS; ++i) {
+      if (!p->pinned(i)) continue;
+      const Scd4xCoWord cur = co_await c.getWord(SCD4X_SETTING_DEFS[i].get);
+      if (!cur.ok) {
+        s.state = Scd4xFleetSensor::FAILED;
+        s.error = "read setting";
+        co_return;
+      }
+      if (cur.value == p->value[i]) continue;
+      s.changed |= (uint8_t)(1u << i);
+      if (dry_run) continue;
+      const bool wrote = co_await c.setWord(SCD4X_SETTING_DEFS[i].set, p->value[i]);
+      const Scd4xCoWord chk = co_await c.getWord(SCD4X_SETTING_DEFS[i].get);
+      if (!wrote || !chk.ok || chk.value != p->value[i]) {
+        s.state = Scd4xFleetSensor::FAILED;
+        s.error = "write setting";
+        co_return;
+      }
+    }
+    if (!dry_run && s.changed && p->persist) {
+      if (!co_await c.persistSettings()) {
+        s.state = Scd4xFleetSensor::FAILED;
+        s.error = "persist";
+        co_return;
+      }
+      s.persisted = true;
+    }
+    if (!dry_run && p->start != Scd4xProfile::IDLE) {
+      const bool ok = p->start == Scd4xProfile::LOW_POWER ? co_await c.startLowPowerPeriodicMeasurement()
+                                                          : co_await c.startPeriodicMeasurement();
+      if (!ok) {
+        s.state = Scd4xFleetSensor::FAILED;
+        s.error = "start";
+        co_return;
+      }
+    }
+    s.state = Scd4xFleetSensor::PROVISIONED;
+    s.provisionUs = (uint32_t)(scd4xMonoUs() - t0);
+  }
+};
+
+#endif  // _7Semi_SCD4X_FLEET_H
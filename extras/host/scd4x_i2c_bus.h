@@ -0,0 +1,334 @@
+#ifndef _7Semi_SCD4X_I2C_BUS_H
+#define _7Semi_SCD4X_I2C_BUS_H
+
+/**
+ * scd4x_i2c_bus.h
+ * ---------------
+ * Host-only I²C transports for running the driver on Linux
+ *
+ * Classes
+ * -------
+ * - Scd4xI2cBus      : plain write / read transactions on one bus
+ * - Scd4xLinuxI2cBus : /dev/i2c-N through ioctl(I2C_RDWR); each call is
+ *                      one kernel transfer and blocks for its bus time
+ * - Scd4xSimI2cBus   : SCD4x sensors (optionally behind a TCA9548A-style
+ *                      mux) fed by Scd4xOfficeSim, with wire-time latency;
+ *                      lets the daemon and tools run without hardware.
+ *                      Settings (offset, altitude, ASC) keep a RAM and an
+ *                      NVM copy; persist_settings counts NVM writes, and
+ *                      commands not allowed while measuring are NACKed
+ * - Scd4xI2cPort     : one sensor = bus + optional mux channel; selects
+ *                      the channel only when it changes
+ *
+ * Notes
+ * -----
+ * - SCD4x commands are a write, an execution wait, then a separate read
+ *   (no repeated start), so write() and read() are separate transfers.
+ * - A bus object is used by one thread at a time (the event loop or the
+ *   bus worker), never both.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <sys/ioctl.h>
+#endif
+
+#include "scd4x_office_sim.h"
+
+/** - Monotonic clock in µs */
+inline uint64_t scd4xMonoUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+class Scd4xI2cBus {
+public:
+  virtual ~Scd4xI2cBus() {}
+  /** - Write n bytes to addr (START … STOP); false on NACK / error */
+  virtual bool write(uint8_t addr, const uint8_t *p, size_t n) = 0;
+  /** - Read n bytes from addr; false on NACK / error */
+  virtual bool read(uint8_t addr, uint8_t *p, size_t n) = 0;
+  virtual const char *name() const = 0;
+
+  /** - Mux channel currently selected on this bus (−1 = unknown) */
+  int muxSelected = -1;
+};
+
+// ======================= Linux i2c-dev =======================
+
+#if defined(__linux__)
+class Scd4xLinuxI2cBus : public Scd4xI2cBus {
+public:
+  explicit Scd4xLinuxI2cBus(const std::string &dev) : path(dev) { fd = ::open(dev.c_str(), O_RDWR); }
+  ~Scd4xLinuxI2cBus() override {
+    if (fd >= 0) ::close(fd);
+  }
+  bool ok() const { return fd >= 0; }
+
+  bool write(uint8_t addr, const uint8_t *p, size_t n) override {
+    struct i2c_msg m = { addr, 0, (uint16_t)n, (uint8_t *)p };
+    return xfer(m);
+  }
+  bool read(uint8_t addr, uint8_t *p, size_t n) override {
+    struct i2c_msg m = { addr, I2C_M_RD, (uint16_t)n, p };
+    return xfer(m);
+  }
+  const char *name() const override { return path.c_str(); }
+
+private:
+  std::string path;
+  int fd = -1;
+
+  bool xfer(struct i2c_msg &m) {
+    struct i2c_rdwr_ioctl_data d = { &m, 1 };
+    return fd >= 0 && ioctl(fd, I2C_RDWR, &d) == 1;
+  }
+};
+#endif
+
+// ======================= Simulated bus =======================
+
+class Scd4xSimI2cBus : public Scd4xI2cBus {
+public:
+  /**
+   * - label    : name shown in reports
+   * - sensors  : SCD4x devices (1 = direct, >1 = behind a mux at 0x70)
+   * - clock_hz : wire speed used for the latency model (0 = no latency)
+   * - seed     : simulator seed base
+   */
+  Scd4xSimI2cBus(const std::string &label, int sensors, uint32_t clock_hz = 100000, uint32_t seed = 1)
+    : tag(label), clock(clock_hz) {
+    for (int i = 0; i < sensors; ++i) {
+      Dev d;
+      d.sim.reset(new Scd4xOfficeSim(seed * 131 + (uint32_t)i + 1, 5000, 60.0 + 20.0 * (i % 4), 1.0, 6));
+      d.serial = ((uint64_t)seed << 24) | (uint64_t)(i + 1);
+      // Real parts run a few ms per period fast or slow
+      d.periodUs = 5000000 + (int64_t)((i * 37) % 21 - 10) * 400;
+      memcpy(d.ram, DEFAULTS, sizeof(d.ram));
+      memcpy(d.nvm, DEFAULTS, sizeof(d.nvm));
+      devs.push_back(std::move(d));
+    }
+    mux = sensors > 1;
+  }
+
+  bool write(uint8_t addr, const uint8_t *p, size_t n) override {
+    wire(n);
+    if (mux && addr == 0x70) {
+      if (n != 1) return false;
+      channel = -1;
+      for (int c = 0; c < 8; ++c)
+        if (p[0] == (1 << c)) channel = c;
+      return true;
+    }
+    Dev *d = dev(addr);
+    if (!d || n < 2) return false;
+    const uint16_t cmd = (uint16_t)(p[0] << 8 | p[1]);
+    if (d->running && !allowedWhileMeasuring(cmd)) return false;
+    d->cmd = cmd;
+    const uint64_t now = scd4xMonoUs();
+    if (n == 5) {
+      for (int i = 0; i < SETTINGS; ++i)
+        if (cmd == SET_CMD[i]) d->ram[i] = (uint16_t)(p[2] << 8 | p[3]);
+    }
+    switch (d->cmd) {
+      case 0x21B1:  // start periodic
+        d->running = true;
+        d->startUs = now;
+        d->taken = 0;
+        break;
+      case 0x21AC:  // start low-power periodic (sim keeps 5 s)
+        d->running = true;
+        d->startUs = now;
+        d->taken = 0;
+        break;
+      case 0x3F86:  // stop
+        d->running = false;
+        break;
+      case 0x3615:  // persist settings
+        memcpy(d->nvm, d->ram, sizeof(d->ram));
+        ++d->nvmWrites;
+        break;
+      case 0x3646:  // reinit: reload from NVM
+        memcpy(d->ram, d->nvm, sizeof(d->ram));
+        break;
+      case 0x3632:  // factory reset
+        memcpy(d->ram, DEFAULTS, sizeof(d->ram));
+        memcpy(d->nvm, DEFAULTS, sizeof(d->nvm));
+        ++d->nvmWrites;
+        break;
+      default:
+        break;
+    }
+    return true;
+  }
+
+  bool read(uint8_t addr, uint8_t *p, size_t n) override {
+    wire(n);
+    Dev *d = dev(addr);
+    if (!d) return false;
+    uint16_t w[3] = { 0, 0, 0 };
+    size_t words = 1;
+    switch (d->cmd) {
+      case 0x3682:  // serial
+        w[0] = (uint16_t)(d->serial >> 32);
+        w[1] = (uint16_t)(d->serial >> 16);
+        w[2] = (uint16_t)d->serial;
+        words = 3;
+        break;
+      case 0xE4B8:  // data ready: low 11 bits non-zero when a new sample exists
+        w[0] = (uint16_t)(available(*d) > d->taken ? 0x8006 : 0x8000);
+        break;
+      case 0xEC05: {  // read measurement
+        const uint64_t k = available(*d);
+        if (k <= d->taken) return false;  // sensor NACKs without new data
+        Scd4xSimSample s;
+        while (d->taken < k) {
+          s = d->sim->next();
+          ++d->taken;
+        }
+        w[0] = s.co2_raw;
+        w[1] = s.t_raw;
+        w[2] = s.rh_raw;
+        words = 3;
+        break;
+      }
+      case 0x202F:  // variant
+        w[0] = 0x1440;
+        break;
+      case 0x362F:  // forced recalibration: correction + 0x8000 (sim: +12 ppm)
+        w[0] = 0x8000 + 12;
+        break;
+      case 0x3639:  // self-test: 0 = no malfunction
+        w[0] = 0;
+        break;
+      default:
+        for (int i = 0; i < SETTINGS; ++i)
+          if (d->cmd == GET_CMD[i]) w[0] = d->ram[i];
+        break;
+    }
+    if (n != words * 3) return false;
+    for (size_t i = 0; i < words; ++i) {
+      p[3 * i] = (uint8_t)(w[i] >> 8);
+      p[3 * i + 1] = (uint8_t)w[i];
+      p[3 * i + 2] = crc8(p[3 * i], p[3 * i + 1]);
+    }
+    return true;
+  }
+
+  const char *name() const override { return tag.c_str(); }
+
+  /** - persist_settings / factory_reset commands seen, all sensors */
+  uint64_t nvmWrites() const {
+    uint64_t n = 0;
+    for (const Dev &d : devs) n += d.nvmWrites;
+    return n;
+  }
+
+private:
+  // temperature offset, altitude, ASC enabled / target / initial / standard
+  static const int SETTINGS = 6;
+  static constexpr uint16_t GET_CMD[SETTINGS] = { 0x2318, 0x2322, 0x2313, 0x233F, 0x2340, 0x234B };
+  static constexpr uint16_t SET_CMD[SETTINGS] = { 0x241D, 0x2427, 0x2416, 0x243A, 0x2445, 0x244E };
+  static constexpr uint16_t DEFAULTS[SETTINGS] = { 1498, 0, 1, 400, 44, 156 };  // 4 °C, 0 m, ASC on
+
+  struct Dev {
+    std::unique_ptr<Scd4xOfficeSim> sim;
+    uint64_t serial = 0;
+    int64_t  periodUs = 5000000;
+    uint16_t cmd = 0;
+    bool     running = false;
+    uint64_t startUs = 0;
+    uint64_t taken = 0;
+    uint16_t ram[SETTINGS];
+    uint16_t nvm[SETTINGS];
+    uint32_t nvmWrites = 0;
+  };
+
+  std::string tag;
+  uint32_t clock;
+  std::vector<Dev> devs;
+  bool mux = false;
+  int  channel = -1;
+
+  Dev *dev(uint8_t addr) {
+    if (addr != 0x62) return nullptr;
+    if (!mux) return &devs[0];
+    return (channel >= 0 && channel < (int)devs.size()) ? &devs[(size_t)channel] : nullptr;
+  }
+
+  /** - read_measurement, data-ready, stop and ambient pressure only */
+  static bool allowedWhileMeasuring(uint16_t cmd) {
+    return cmd == 0xEC05 || cmd == 0xE4B8 || cmd == 0x3F86 || cmd == 0xE000;
+  }
+
+  /** - Samples produced since start (first one after one period) */
+  static uint64_t available(const Dev &d) {
+    if (!d.running) return 0;
+    return (scd4xMonoUs() - d.startUs) / (uint64_t)d.periodUs;
+  }
+
+  /** - Block for the wire time of address + n bytes (9 bits each) */
+  void wire(size_t n) {
+    if (!clock) return;
+    const uint64_t ns = (uint64_t)(n + 1) * 9 * 1000000000ULL / clock;
+    struct timespec ts = { (time_t)(ns / 1000000000ULL), (long)(ns % 1000000000ULL) };
+    nanosleep(&ts, nullptr);
+  }
+
+  static uint8_t crc8(uint8_t b0, uint8_t b1) {
+    uint8_t crc = 0xFF;
+    crc ^= b0;
+    for (int i = 0; i < 8; ++i) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    crc ^= b1;
+    for (int i = 0; i < 8; ++i) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    return crc;
+  }
+};
+
+// ======================= Port (bus + mux channel) =======================
+
+class Scd4xI2cPort {
+public:
+  /**
+   * - bus     : shared bus
+   * - muxAddr : 0 = no mux, else mux address (0x70–0x77)
+   * - channel : mux channel 0–7
+   */
+  Scd4xI2cPort(Scd4xI2cBus *bus = nullptr, uint8_t muxAddr = 0, int channel = 0)
+    : bus(bus), muxAddr(muxAddr), channel(channel) {}
+
+  bool write(uint8_t addr, const uint8_t *p, size_t n) { return select() && bus->write(addr, p, n); }
+  bool read(uint8_t addr, uint8_t *p, size_t n) { return select() && bus->read(addr, p, n); }
+
+  Scd4xI2cBus *bus;
+  uint8_t muxAddr;
+  int channel;
+
+private:
+  bool select() {
+    if (!bus) return false;
+    if (!muxAddr || bus->muxSelected == channel) return true;
+    const uint8_t m = (uint8_t)(1 << channel);
+    if (!bus->write(muxAddr, &m, 1)) {
+      bus->muxSelected = -1;
+      return false;
+    }
+    bus->muxSelected = channel;
+    return true;
+  }
+};
+
+#endif  // _7Semi_SCD4X_I2C_BUS_H
@@ -0,0 +1,334 @@
+#ifndef _7Semi_SCD4X_LOG_READER_H
+#define _7Semi_SCD4X_LOG_READER_H
+
+/**
+ * scd4x_log_reader.h
+ * ------------------
+ * Host-only memory-mapped reader for SCD4x_Log_7Semi files
+ *
+ * Usage
+ * -----
+ *   Scd4xLogReader r;
+ *   if (!r.open("scd4x.log")) ...
+ *   r.info().serial, r.info().variant ...        // from the header block
+ *   for (Scd4xLogBlock b : r) {                   // zero-copy block views
+ *     if (!b.isSamples() || !b.valid()) continue; // CRC checked on demand
+ *     b.decode([](const SCD4x_RawSample_7Semi &s) { ... });
+ *   }
+ *
+ *   Scd4xLogQuery q;                              // CO₂ ≥ 1500 ppm in a window
+ *   q.fromKey = ...; q.toKey = ...; q.co2Lo = 1500;
+ *   r.query(q, [](uint64_t key, const SCD4x_RawSample_7Semi &s) { ... });
+ *
+ * Notes
+ * -----
+ * - The file is mapped read-only; block views point into the mapping and
+ *   nothing is parsed until asked. Walking block headers of a year of 5 s
+ *   samples touches one cache line per block.
+ * - Files written before the header block existed (block 0 is a sample
+ *   block) are accepted with the block size passed to open().
+ * - t_ms is the writer's 32-bit millis(); forEachSample() unwraps it to
+ *   64 bits across blocks in file order.
+ * - query() binary-searches the blocks by zone-map time key, then skips every
+ *   block whose min/max cannot satisfy the value ranges; only the remaining
+ *   blocks are CRC-checked and decoded. Blocks without a zone map are never
+ *   skipped on values.
+ */
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "7Semi_SCD4x_Log.h"
+
+/** - View of one block inside the mapping */
+class Scd4xLogBlock {
+public:
+  Scd4xLogBlock(const uint8_t *p, uint16_t size) : p(p), size(size) {}
+
+  const uint8_t *data() const { return p; }
+  uint8_t  type() const { return p[5]; }
+  uint8_t  encoding() const { return p[6]; }
+  uint32_t sequence() const { return u32(p + 8); }
+  uint64_t serial() const { return u32(p + 12) | ((uint64_t)u16(p + 16) << 32); }
+  uint16_t count() const { return isSamples() ? u16(p + 18) : 0; }
+  uint16_t payloadLength() const { return u16(p + 20); }
+  const uint8_t *payload() const { return p + SCD4X_LOG_HEADER_LEN; }
+
+  bool hasMagic() const {
+    return p[0] == SCD4X_LOG_MAGIC0 && p[1] == SCD4X_LOG_MAGIC1 &&
+           p[2] == SCD4X_LOG_MAGIC2 && p[3] == SCD4X_LOG_MAGIC3;
+  }
+  bool isSamples() const { return hasMagic() && p[5] == SCD4X_LOG_TYPE_SAMPLES; }
+  /** - Magic + CRC-32 over the whole block */
+  bool valid() const { return SCD4x_Log_7Semi::validBlock(p, size); }
+
+  /** - Zone map (false for blocks written without one) */
+  bool zone(SCD4x_LogZone_7Semi &z) const { return hasMagic() && SCD4x_Log_7Semi::readZone(p, size, z); }
+
+  /** - t_ms of the first sample, without decoding */
+  uint32_t firstMs() const {
+    if (encoding() == SCD4X_LOG_ENC_RAW) return u32(payload());
+    return u32(payload() + 5);
+  }
+
+  /**
+   * - Decode samples, calling f(const SCD4x_RawSample_7Semi &) for each
+   * - return : samples delivered (0 on a malformed payload)
+   */
+  template <class F>
+  size_t decode(F &&f) const {
+    const uint16_t n = count();
+    const uint16_t len = payloadLength();
+    if (len > size - SCD4X_LOG_HEADER_LEN - 4) return 0;
+    if (encoding() == SCD4X_LOG_ENC_RAW) {
+      if ((size_t)n * SCD4X_LOG_RAW_RECORD > len) return 0;
+      const uint8_t *r = payload();
+      for (uint16_t i = 0; i < n; ++i, r += SCD4X_LOG_RAW_RECORD) {
+        SCD4x_RawSample_7Semi s = { u32(r), u16(r + 4), u16(r + 6), u16(r + 8) };
+        f(s);
+      }
+      return n;
+    }
+    SCD4x_DeltaDecoder_7Semi d;
+    if (!d.open(payload(), len)) return 0;
+    SCD4x_RawSample_7Semi s;
+    size_t k = 0;
+    while (d.next(s)) {
+      f(s);
+      ++k;
+    }
+    return k;
+  }
+
+private:
+  const uint8_t *p;
+  uint16_t size;
+
+  static uint16_t u16(const uint8_t *q) { return (uint16_t)(q[0] | (q[1] << 8)); }
+  static uint32_t u32(const uint8_t *q) { return (uint32_t)u16(q) | ((uint32_t)u16(q + 2) << 16); }
+};
+
+/**
+ * - Time window + value ranges, all inclusive
+ * - Keys are (epoch << 32) | t_ms as in SCD4x_LogZone_7Semi
+ * - Value bounds are raw words (co2_raw = ppm; see SCD4x_RawSample_7Semi)
+ */
+struct Scd4xLogQuery {
+  uint64_t fromKey = 0;
+  uint64_t toKey = UINT64_MAX;
+  uint16_t co2Lo = 0, co2Hi = 0xFFFF;
+  uint16_t tLo = 0, tHi = 0xFFFF;
+  uint16_t rhLo = 0, rhHi = 0xFFFF;
+
+  /** - Can a block with this zone map hold a match? */
+  bool mayMatch(const SCD4x_LogZone_7Semi &z) const {
+    return z.lastKey() >= fromKey && z.firstKey() <= toKey &&
+           z.co2Max >= co2Lo && z.co2Min <= co2Hi &&
+           z.tMax >= tLo && z.tMin <= tHi &&
+           z.rhMax >= rhLo && z.rhMin <= rhHi;
+  }
+  bool matches(uint64_t key, const SCD4x_RawSample_7Semi &s) const {
+    return key >= fromKey && key <= toKey &&
+           s.co2_raw >= co2Lo && s.co2_raw <= co2Hi &&
+           s.t_raw >= tLo && s.t_raw <= tHi &&
+           s.rh_raw >= rhLo && s.rh_raw <= rhHi;
+  }
+};
+
+/** - Work done by the last query() */
+struct Scd4xLogQueryStats {
+  size_t blocksInRange = 0;   // blocks overlapping the time window
+  size_t blocksSkipped = 0;   // pruned by the zone map
+  size_t blocksDecoded = 0;
+  size_t badBlocks = 0;
+  uint64_t samplesScanned = 0;
+};
+
+class Scd4xLogReader {
+public:
+  Scd4xLogReader() {}
+  ~Scd4xLogReader() { close(); }
+  Scd4xLogReader(const Scd4xLogReader &) = delete;
+  Scd4xLogReader &operator=(const Scd4xLogReader &) = delete;
+
+  /**
+   * - Map a log file read-only and parse its header block
+   * - fallback_block_size : used for files without a header block
+   * - return : false if the file cannot be mapped or has no valid layout
+   */
+  bool open(const char *path, uint16_t fallback_block_size = 512) {
+    close();
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < SCD4X_LOG_MIN_BLOCK) {
+      ::close(fd);
+      return false;
+    }
+    len = (size_t)st.st_size;
+    void *m = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (m == MAP_FAILED) {
+      len = 0;
+      return false;
+    }
+    base = (const uint8_t *)m;
+    madvise(m, len, MADV_SEQUENTIAL);
+
+    info_ = SCD4x_LogInfo_7Semi();
+    if (SCD4x_Log_7Semi::parseHeader(base, len, info_)) {
+      bs = info_.blockSize;
+      first = 1;
+      headerOk = true;
+    } else {
+      bs = fallback_block_size;
+      first = 0;
+      headerOk = false;
+      Scd4xLogBlock b0(base, bs);
+      if (bs < SCD4X_LOG_MIN_BLOCK || len < bs || !b0.isSamples()) {
+        close();
+        return false;
+      }
+      info_.blockSize = bs;
+      info_.encoding = b0.encoding();
+      info_.serial = b0.serial();
+    }
+    return true;
+  }
+
+  void close() {
+    if (base) munmap((void *)base, len);
+    base = nullptr;
+    len = 0;
+  }
+
+  /** - Header block contents (blockSize / encoding always set) */
+  const SCD4x_LogInfo_7Semi &info() const { return info_; }
+  /** - False for files written without a header block */
+  bool hasHeader() const { return headerOk; }
+  /** - Data blocks (header block excluded, partial tail ignored) */
+  size_t blockCount() const { return base ? len / bs - first : 0; }
+  /** - i-th data block */
+  Scd4xLogBlock block(size_t i) const { return Scd4xLogBlock(base + (i + first) * bs, bs); }
+
+  // ------------------------ Iteration ------------------------
+  class iterator {
+  public:
+    iterator(const Scd4xLogReader *r, size_t i) : r(r), i(i) {}
+    Scd4xLogBlock operator*() const { return r->block(i); }
+    iterator &operator++() { ++i; return *this; }
+    bool operator!=(const iterator &o) const { return i != o.i; }
+
+  private:
+    const Scd4xLogReader *r;
+    size_t i;
+  };
+  iterator begin() const { return iterator(this, 0); }
+  iterator end() const { return iterator(this, blockCount()); }
+
+  /**
+   * - Decode every valid sample block in file order
+   * - f(uint64_t t_ms_unwrapped, const SCD4x_RawSample_7Semi &)
+   * - return : samples delivered; bad blocks are counted in badBlocks()
+   */
+  template <class F>
+  uint64_t forEachSample(F &&f) {
+    uint64_t total = 0;
+    uint64_t epoch = 0;
+    uint32_t last = 0;
+    bad = 0;
+    for (Scd4xLogBlock b : *this) {
+      if (!b.isSamples()) continue;
+      if (!b.valid()) {
+        ++bad;
+        continue;
+      }
+      total += b.decode([&](const SCD4x_RawSample_7Semi &s) {
+        if (s.t_ms < last) epoch += 1ULL << 32;
+        last = s.t_ms;
+        f(epoch + s.t_ms, s);
+      });
+    }
+    return total;
+  }
+
+  /** - Blocks with a bad CRC seen by the last forEachSample() */
+  size_t badBlocks() const { return bad; }
+
+  /**
+   * - First data block whose zone map ends at or after key
+   * - Blocks without a zone map (torn / old) are stepped over while probing
+   */
+  size_t seek(uint64_t key) const {
+    size_t lo = 0, hi = blockCount();
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+      size_t i = mid;
+      SCD4x_LogZone_7Semi z;
+      while (i < hi && !block(i).zone(z)) ++i;
+      if (i == hi) hi = mid;
+      else if (z.lastKey() < key) lo = i + 1;
+      else hi = mid;
+    }
+    return lo;
+  }
+
+  /**
+   * - Deliver samples matching q, in file order
+   * - f(uint64_t key, const SCD4x_RawSample_7Semi &)
+   * - return : matching samples
+   */
+  template <class F>
+  uint64_t query(const Scd4xLogQuery &q, F &&f) {
+    qs = Scd4xLogQueryStats();
+    uint64_t hits = 0;
+    for (size_t i = seek(q.fromKey); i < blockCount(); ++i) {
+      Scd4xLogBlock b = block(i);
+      if (!b.isSamples()) continue;
+      SCD4x_LogZone_7Semi z;
+      const bool hasZone = b.zone(z);
+      if (hasZone && z.firstKey() > q.toKey) break;
+      ++qs.blocksInRange;
+      if (hasZone && !q.mayMatch(z)) {
+        ++qs.blocksSkipped;
+        continue;
+      }
+      if (!b.valid()) {
+        ++qs.badBlocks;
+        continue;
+      }
+      ++qs.blocksDecoded;
+      uint64_t ep = hasZone ? z.epochFirst : 0;
+      uint32_t prev = hasZone ? z.tFirst : 0;
+      qs.samplesScanned += b.decode([&](const SCD4x_RawSample_7Semi &s) {
+        if (s.t_ms < prev) ++ep;
+        prev = s.t_ms;
+        const uint64_t key = (ep << 32) | s.t_ms;
+        if (q.matches(key, s)) {
+          ++hits;
+          f(key, s);
+        }
+      });
+    }
+    return hits;
+  }
+
+  /** - Counters of the last query() */
+  const Scd4xLogQueryStats &queryStats() const { return qs; }
+
+private:
+  const uint8_t *base = nullptr;
+  size_t   len = 0;
+  uint16_t bs = 0;
+  size_t   first = 0;
+  bool     headerOk = false;
+  size_t   bad = 0;
+  SCD4x_LogInfo_7Semi info_;
+  Scd4xLogQueryStats qs;
+};
+
+#endif  // _7Semi_SCD4X_LOG_READER_H
@@ -0,0 +1,356 @@
+#ifndef _7Semi_SCD4X_METRICS_H
+#define _7Semi_SCD4X_METRICS_H
+
+/**
+ * scd4x_metrics.h
+ * ---------------
+ * Host-only Prometheus text exposition over a Unix domain socket, built
+ * for an event loop that must never block
+ *
+ * Classes
+ * -------
+ * - Scd4xPromText        : appends families / samples into a fixed buffer
+ *                          (snprintf into the tail, never allocates)
+ * - Scd4xLatencyHistogram: fixed-bucket histogram, rendered as a
+ *                          Prometheus histogram in seconds
+ * - Scd4xMetricsServer   : non-blocking listener + a fixed set of client
+ *                          slots; each client's request is read, then
+ *                          answered with an HTTP/1.0 response carrying
+ *                          the current snapshot, then closed
+ *
+ * Notes
+ * -----
+ * - All buffers are sized once at startup. A scrape re-renders the
+ *   snapshot only when no client is still sending the previous one, so a
+ *   slow scraper can delay fresh numbers but never the event loop.
+ * - A snapshot that outgrows the buffer is never served cut short: the
+ *   scrape gets a 500 and truncations() counts it, so the caller can log
+ *   it and export it on the next scrape that fits.
+ * - Accept / send are driven by the caller's epoll (EPOLLIN on the
+ *   listener, EPOLLOUT on a client with a partial send).
+ * - Works with `curl --unix-socket PATH http://localhost/metrics` and
+ *   any exporter or agent that can scrape a Unix socket.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+class Scd4xPromText {
+public:
+  /** - cap : bytes reserved once; output beyond it is dropped and flagged */
+  explicit Scd4xPromText(size_t cap = 0) : buf(cap ? cap : 1) {}
+
+  void reserve(size_t cap) {
+    if (cap > buf.size()) buf.resize(cap);
+  }
+  void clear() {
+    len = 0;
+    truncated = false;
+  }
+
+  /** - # HELP / # TYPE lines for one family */
+  void family(const char *name, const char *type, const char *help) {
+    printf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+  }
+  /** - name{labels} value (labels may be empty) */
+  void sample(const char *name, const char *labels, double v) {
+    if (labels && *labels) printf("%s{%s} %.9g\n", name, labels, v);
+    else printf("%s %.9g\n", name, v);
+  }
+  void sampleU(const char *name, const char *labels, uint64_t v) {
+    if (labels && *labels) printf("%s{%s} %llu\n", name, labels, (unsigned long long)v);
+    else printf("%s %llu\n", name, (unsigned long long)v);
+  }
+
+  /** - printf-style append into the remaining space */
+  void printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+    if (truncated) return;
+    va_list ap;
+    va_start(ap, fmt);
+    const int n = vsnprintf(buf.data() + len, buf.size() - len, fmt, ap);
+    va_end(ap);
+    if (n < 0 || (size_t)n >= buf.size() - len) {
+      truncated = true;
+      return;
+    }
+    len += (size_t)n;
+  }
+
+  const char *data() const { return buf.data(); }
+  char *data() { return buf.data(); }
+  size_t size() const { return len; }
+  size_t capacity() const { return buf.size(); }
+  bool overflow() const { return truncated; }
+
+private:
+  std::vector<char> buf;
+  size_t len = 0;
+  bool truncated = false;
+};
+
+// ======================= Histogram =======================
+
+class Scd4xLatencyHistogram {
+public:
+  static const int BUCKETS = 10;
+
+  /** - Record one duration in µs */
+  void observe(uint64_t us) {
+    int i = 0;
+    while (i < BUCKETS && us > boundUs(i)) ++i;
+    ++counts[i];
+    sumUs += us;
+    ++n;
+  }
+
+  uint64_t count() const { return n; }
+
+  /** - name_bucket / name_sum / name_count; labels are extra labels or "" */
+  void render(Scd4xPromText &t, const char *name, const char *labels) const {
+    const char *sep = (labels && *labels) ? "," : "";
+    uint64_t cum = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+      cum += counts[i];
+      t.printf("%s_bucket{%s%sle=\"%g\"} %llu\n", name, labels, sep, boundUs(i) / 1e6, (unsigned long long)cum);
+    }
+    t.printf("%s_bucket{%s%sle=\"+Inf\"} %llu\n", name, labels, sep, (unsigned long long)n);
+    t.printf("%s_sum{%s} %.6f\n", name, labels, sumUs / 1e6);
+    t.printf("%s_count{%s} %llu\n", name, labels, (unsigned long long)n);
+  }
+
+private:
+  uint64_t counts[BUCKETS + 1] = {};
+  uint64_t sumUs = 0;
+  uint64_t n = 0;
+
+  /** - 100 µs … 100 ms; covers a single 100 kHz transfer up to a slow bus */
+  static uint64_t boundUs(int i) {
+    static const uint64_t b[BUCKETS] = { 100, 250, 500, 1000, 1500, 2000, 5000, 10000, 25000, 100000 };
+    return b[i];
+  }
+};
+
+// ======================= Server =======================
+
+class Scd4xMetricsServer {
+public:
+  /** - max_clients : concurrent scrapes; extra connections are closed at once */
+  explicit Scd4xMetricsServer(unsigned max_clients = 4) : clients(max_clients) {}
+  ~Scd4xMetricsServer() { close(); }
+
+  /**
+   * - Bind a non-blocking listener at path (a stale socket file is replaced)
+   * - snapshot_bytes : buffer reserved for one rendered scrape
+   */
+  bool listen(const char *path, size_t snapshot_bytes) {
+    close();
+    struct sockaddr_un a;
+    memset(&a, 0, sizeof(a));
+    a.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(a.sun_path)) return false;
+    strcpy(a.sun_path, path);
+    lfd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (lfd < 0) return false;
+    unlink(path);
+    if (bind(lfd, (struct sockaddr *)&a, sizeof(a)) != 0 || ::listen(lfd, 16) != 0) {
+      close();
+      return false;
+    }
+    sockPath = path;
+    text.reserve(snapshot_bytes + HEADER_MAX);
+    return true;
+  }
+
+  /** - Register the listener with epoll; client i uses tag base + 1 + i */
+  void attach(int epoll_fd, uint64_t tag_base) {
+    ep = epoll_fd;
+    base = tag_base;
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.u64 = base;
+    epoll_ctl(ep, EPOLL_CTL_ADD, lfd, &ev);
+  }
+
+  bool owns(uint64_t tag) const { return lfd >= 0 && tag >= base && tag <= base + clients.size(); }
+
+  /**
+   * - Handle an epoll event for one of our tags
+   * - render(Scd4xPromText&) appends the metric families for a new snapshot
+   */
+  template <class R>
+  void onEvent(uint64_t tag, R &&render) {
+    if (tag == base) {
+      accept();
+      return;
+    }
+    Client &c = clients[(size_t)(tag - base - 1)];
+    if (c.responding) flush(c);
+    else request(c, render);
+  }
+
+  uint64_t scrapes() const { return nScrapes; }
+  uint64_t dropped() const { return nDropped; }
+  /** - Snapshots that did not fit the buffer (each answered with a 500) */
+  uint64_t truncations() const { return nTruncated; }
+
+  void close() {
+    for (Client &c : clients) drop(c);
+    if (lfd >= 0) {
+      ::close(lfd);
+      unlink(sockPath.c_str());
+    }
+    lfd = -1;
+  }
+
+private:
+  static const size_t HEADER_MAX = 96;
+  static const time_t IDLE_S = 5;
+
+  struct Client {
+    int fd = -1;
+    bool responding = false;
+    size_t off = 0;
+    time_t since = 0;
+  };
+
+  int lfd = -1, ep = -1;
+  uint64_t base = 0;
+  std::string sockPath;
+  std::vector<Client> clients;
+  Scd4xPromText text;
+  size_t bodyStart = 0;
+  unsigned sending = 0;
+  uint64_t nScrapes = 0, nDropped = 0, nTruncated = 0;
+
+  void watch(Client &c, uint32_t events, int op) {
+    struct epoll_event ev;
+    ev.events = events;
+    ev.data.u64 = base + 1 + (uint64_t)(&c - clients.data());
+    epoll_ctl(ep, op, c.fd, &ev);
+  }
+
+  void accept() {
+    const time_t now = time(nullptr);
+    for (;;) {
+      const int fd = accept4(lfd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (fd < 0) return;  // EAGAIN: drained
+      Client *slot = nullptr;
+      for (Client &c : clients) {
+        if (c.fd >= 0 && !c.responding && now - c.since > IDLE_S) drop(c);  // never sent a request
+        if (c.fd < 0 && !slot) slot = &c;
+      }
+      if (!slot) {
+        ++nDropped;
+        ::close(fd);
+        continue;
+      }
+      slot->fd = fd;
+      slot->responding = false;
+      slot->off = 0;
+      slot->since = now;
+      watch(*slot, EPOLLIN, EPOLL_CTL_ADD);
+    }
+  }
+
+  /**
+   * - Consume the request, then answer. The request must be read first:
+   *   closing an AF_UNIX socket with unread input resets the peer, which
+   *   then discards the response.
+   */
+  template <class R>
+  void request(Client &c, R &render) {
+    char tmp[512];
+    bool any = false;
+    for (;;) {
+      const ssize_t r = recv(c.fd, tmp, sizeof(tmp), 0);
+      if (r > 0) {
+        any = true;
+        continue;
+      }
+      if (r == 0) any = true;  // EOF after (or instead of) a request
+      else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        drop(c);
+        return;
+      }
+      break;
+    }
+    if (!any) return;
+    // Fresh snapshot only when nobody is mid-send of the old one
+    if (sending == 0) snapshot(render);
+    c.responding = true;
+    ++sending;
+    ++nScrapes;
+    watch(c, EPOLLOUT, EPOLL_CTL_MOD);
+    flush(c);
+  }
+
+  template <class R>
+  void snapshot(R &render) {
+    // Body first at a fixed offset, then the header written in front of it
+    text.clear();
+    text.printf("%*s", (int)HEADER_MAX, "");
+    render(text);
+    if (text.overflow()) {
+      // A partial body would scrape as valid with series missing
+      ++nTruncated;
+      const size_t cap = text.capacity();
+      char msg[64];
+      const int m = snprintf(msg, sizeof(msg), "metrics snapshot exceeds %zu bytes\n", cap - HEADER_MAX);
+      text.clear();
+      text.printf("HTTP/1.0 500 Internal Server Error\r\nContent-Type: text/plain\r\nContent-Length: %d\r\n\r\n%s", m,
+                  msg);
+      bodyStart = 0;
+      return;
+    }
+    const size_t body = text.size() - HEADER_MAX;
+    char hdr[HEADER_MAX + 1];
+    const int h = snprintf(hdr, sizeof(hdr),
+                           "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %zu\r\n\r\n",
+                           body);
+    bodyStart = HEADER_MAX - (size_t)h;
+    memcpy(text.data() + bodyStart, hdr, (size_t)h);
+  }
+
+  void flush(Client &c) {
+    if (c.fd < 0) return;
+    const size_t total = text.size() - bodyStart;
+    while (c.off < total) {
+      const ssize_t w = send(c.fd, text.data() + bodyStart + c.off, total - c.off, MSG_NOSIGNAL);
+      if (w > 0) {
+        c.off += (size_t)w;
+        continue;
+      }
+      if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;  // resume on EPOLLOUT
+      break;  // peer gone
+    }
+    // Drain anything the client sent after its request before closing
+    shutdown(c.fd, SHUT_WR);
+    char tmp[256];
+    while (recv(c.fd, tmp, sizeof(tmp), 0) > 0) {
+    }
+    drop(c);
+  }
+
+  void drop(Client &c) {
+    if (c.fd < 0) return;
+    if (ep >= 0) epoll_ctl(ep, EPOLL_CTL_DEL, c.fd, nullptr);
+    ::close(c.fd);
+    c.fd = -1;
+    if (c.responding) --sending;
+    c.responding = false;
+  }
+};
+
+#endif  // _7Semi_SCD4X_METRICS_H
@@ -0,0 +1,120 @@
+#ifndef _7Semi_SCD4X_OFFICE_SIM_H
+#define _7Semi_SCD4X_OFFICE_SIM_H
+
+/**
+ * scd4x_office_sim.h
+ * ------------------
+ * Host-only synthetic SCD4x data: one office zone, day by day
+ *
+ * Model
+ * -----
+ * - Occupancy: weekdays 08:30–17:30, lunch dip 12:00–13:00, random head
+ *   count per half hour (0..max_people), empty at night and on weekends.
+ * - CO₂: single-zone mass balance (same model as SCD4x_Occupancy_7Semi),
+ *   plus SCD41-like noise (±(10 ppm + 3 %) bound, Gaussian-ish).
+ * - T: 21 °C base, occupant / solar gain, slow daily swing.
+ * - RH: follows occupant moisture and drops as T rises.
+ * - Outputs both decoded values and the raw words readMeasurement() decodes.
+ *
+ * Notes
+ * -----
+ * - Deterministic: same seed → same series (xorshift32).
+ * - Header-only; used by the host benchmarks and tools in extras/host.
+ */
+
+#include <stdint.h>
+#include <math.h>
+
+struct Scd4xSimSample {
+  uint32_t t_ms;      // time since simulation start
+  uint16_t co2_ppm;
+  int16_t  temp_c;    // 0.01 °C
+  uint16_t rh_c;      // 0.01 %RH
+  uint16_t co2_raw;   // raw words as on the wire
+  uint16_t t_raw;
+  uint16_t rh_raw;
+  uint8_t  people;    // true occupancy (ground truth)
+};
+
+class Scd4xOfficeSim {
+public:
+  /**
+   * - seed       : PRNG seed (non-zero)
+   * - period_ms  : sample period (5000 = periodic mode)
+   * - volume_m3  : zone volume
+   * - ach        : air changes per hour
+   * - max_people : peak occupancy
+   */
+  explicit Scd4xOfficeSim(uint32_t seed = 1, uint32_t period_ms = 5000,
+                          double volume_m3 = 120.0, double ach = 1.2, int max_people = 8)
+    : rng(seed ? seed : 1), period(period_ms), volume(volume_m3), ach(ach), maxPeople(max_people) {}
+
+  /** - Produce the next sample */
+  Scd4xSimSample next() {
+    const double dt = period / 1000.0;
+    const double hour = fmod(now / 3600000.0, 24.0);
+    const int day = (int)(now / 86400000ULL) % 7;  // 0..4 weekdays
+
+    // Re-draw head count every 30 min
+    const uint64_t slot = now / 1800000ULL;
+    if (slot != lastSlot) {
+      lastSlot = slot;
+      bool open = day < 5 && hour >= 8.5 && hour < 17.5;
+      bool lunch = hour >= 12.0 && hour < 13.0;
+      int cap = lunch ? maxPeople / 3 : maxPeople;
+      people = open ? (int)(uniform() * (cap + 1)) : 0;
+    }
+
+    // CO₂ mass balance, C in ppm, G in mL/min (312 per person)
+    const double g = people * 312.0;
+    co2 += dt * ((g / volume) / 60.0 - (ach / 3600.0) * (co2 - 420.0));
+
+    // Temperature and humidity
+    const double tTarget = 21.0 + 0.15 * people + 0.8 * sin((hour - 9.0) * M_PI / 12.0);
+    temp += (tTarget - temp) * dt / 1800.0;
+    const double rhTarget = 42.0 + 0.6 * people - 2.5 * (temp - 21.0);
+    rh += (rhTarget - rh) * dt / 2400.0;
+
+    Scd4xSimSample s;
+    s.t_ms = (uint32_t)now;
+    const double c = co2 + noise() * (3.0 + 0.01 * co2);
+    s.co2_ppm = (uint16_t)(c < 0 ? 0 : c + 0.5);
+    const double tm = temp + noise() * 0.02;
+    const double hm = rh + noise() * 0.1;
+    s.t_raw = (uint16_t)((tm + 45.0) * 65535.0 / 175.0 + 0.5);
+    s.rh_raw = (uint16_t)(hm * 65535.0 / 100.0 + 0.5);
+    s.co2_raw = s.co2_ppm;
+    s.temp_c = (int16_t)lround((-45.0 + 175.0 * s.t_raw / 65535.0) * 100.0);
+    s.rh_c = (uint16_t)lround(100.0 * s.rh_raw / 65535.0 * 100.0);
+    s.people = (uint8_t)people;
+
+    now += period;
+    return s;
+  }
+
+private:
+  uint32_t rng;
+  uint32_t period;
+  double volume;
+  double ach;
+  int maxPeople;
+
+  uint64_t now = 0;
+  uint64_t lastSlot = UINT64_MAX;
+  int people = 0;
+  double co2 = 430.0;
+  double temp = 21.0;
+  double rh = 42.0;
+
+  uint32_t xorshift() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+  }
+  double uniform() { return (xorshift() >> 8) / 16777216.0; }
+  /** - Approximately N(0,1) (sum of 4 uniforms) */
+  double noise() { return (uniform() + uniform() + uniform() + uniform() - 2.0) * 1.732; }
+};
+
+#endif  // _7Semi_SCD4X_OFFICE_SIM_H
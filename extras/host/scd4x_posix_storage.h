@@ -0,0 +1,62 @@
+#ifndef _7Semi_SCD4X_POSIX_STORAGE_H
+#define _7Semi_SCD4X_POSIX_STORAGE_H
+
+/**
+ * scd4x_posix_storage.h
+ * ---------------------
+ * Host-only SCD4x_LogStorage_7Semi over a POSIX file descriptor
+ *
+ * Notes
+ * -----
+ * - pread / pwrite at absolute offsets, so the log writer and a reader
+ *   (or a second mapping) never fight over a shared file position.
+ * - sync() is fdatasync(); pass sync_every = 0 to the writer for bulk
+ *   generation where durability does not matter.
+ */
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "7Semi_SCD4x_Log.h"
+
+class Scd4xPosixStorage : public SCD4x_LogStorage_7Semi {
+public:
+  Scd4xPosixStorage() {}
+  ~Scd4xPosixStorage() override { close(); }
+
+  /**
+   * - Open (and create) path for read + write
+   * - truncate : start an empty log
+   */
+  bool open(const char *path, bool truncate = false) {
+    close();
+    fd = ::open(path, O_RDWR | O_CREAT | (truncate ? O_TRUNC : 0), 0644);
+    return fd >= 0;
+  }
+
+  void close() {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+  }
+
+  uint32_t size() override {
+    struct stat st;
+    return (fd >= 0 && fstat(fd, &st) == 0) ? (uint32_t)st.st_size : 0;
+  }
+
+  bool read(uint32_t offset, uint8_t *buf, size_t n) override {
+    return fd >= 0 && pread(fd, buf, n, offset) == (ssize_t)n;
+  }
+
+  bool write(uint32_t offset, const uint8_t *buf, size_t n) override {
+    return fd >= 0 && pwrite(fd, buf, n, offset) == (ssize_t)n;
+  }
+
+  bool sync() override { return fd >= 0 && fdatasync(fd) == 0; }
+
+private:
+  int fd = -1;
+};
+
+#endif  // _7Semi_SCD4X_POSIX_STORAGE_H
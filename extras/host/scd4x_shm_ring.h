@@ -0,0 +1,241 @@
+#ifndef _7Semi_SCD4X_SHM_RING_H
+#define _7Semi_SCD4X_SHM_RING_H
+
+/**
+ * scd4x_shm_ring.h
+ * ----------------
+ * Host-only POSIX shared-memory ring: one writer (the acquisition daemon)
+ * publishes decoded samples, any number of reader processes consume them
+ *
+ * Protocol
+ * --------
+ * - Fixed slots, power-of-two count. Sample n goes to slot n & mask.
+ * - Per-slot seqlock: the writer stores seq = 2n+1 (writing), copies the
+ *   payload, then stores seq = 2n+2 (published, release). head = n+1 is
+ *   stored last.
+ * - A reader keeps its own cursor (nothing in shared memory is written by
+ *   readers, so the mapping is read-only and readers never disturb each
+ *   other or the writer). It reads seq, copies the slot, re-reads seq;
+ *   the copy is valid only if both equal 2n+2.
+ * - Overrun: if the writer got more than one lap ahead, or lapped the slot
+ *   during the copy, the reader skips to the oldest sample still in the
+ *   ring and counts what it lost.
+ *
+ * Notes
+ * -----
+ * - No syscalls on either side after open: publish is two stores and a
+ *   40-byte copy; poll is loads and a 40-byte copy out of the mapping
+ *   (the seqlock needs the private copy to validate it).
+ * - Readers that want to block should back off (see shm_ring_bench.cpp);
+ *   at 5 s sample periods a 1 ms sleep is invisible.
+ * - The writer unlinks nothing on exit, so readers can attach before or
+ *   after the daemon starts; create() re-initializes the ring.
+ */
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+
+/** - One published sample (40 bytes) */
+struct Scd4xShmSample {
+  uint64_t unixMs;   // wall clock at read
+  uint64_t monoNs;   // CLOCK_MONOTONIC at publish (latency measurement)
+  uint64_t serial;   // 48-bit sensor serial
+  uint16_t co2;      // ppm
+  uint16_t tRaw;     // datasheet raw temperature word
+  uint16_t rhRaw;    // datasheet raw RH word
+  uint8_t  bus;      // daemon bus index
+  int8_t   channel;  // mux channel, −1 = direct
+  uint32_t flags;
+  uint32_t reserved;
+};
+
+class Scd4xShmRing {
+public:
+  enum Result { EMPTY = 0, OK = 1, OVERRUN = 2 };
+
+  Scd4xShmRing() {}
+  ~Scd4xShmRing() { close(); }
+  Scd4xShmRing(const Scd4xShmRing &) = delete;
+  Scd4xShmRing &operator=(const Scd4xShmRing &) = delete;
+
+  /**
+   * - Writer: create (or reset) the ring /name with 2^slots_log2 slots
+   * - return : false on shm_open / ftruncate / mmap failure
+   */
+  bool create(const char *name, unsigned slots_log2 = 12) {
+    close();
+    const uint64_t slots = 1ULL << slots_log2;
+    const size_t bytes = sizeof(Header) + (size_t)slots * sizeof(Slot);
+    const int fd = shm_open(name, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+    if (ftruncate(fd, (off_t)bytes) != 0) {
+      ::close(fd);
+      return false;
+    }
+    if (!map(fd, bytes, PROT_READ | PROT_WRITE)) return false;
+    // Invalidate first so an attached reader sees an unusable ring, not a torn one
+    hdr->magic.store(0, std::memory_order_relaxed);
+    hdr->slots = slots;
+    hdr->slotSize = sizeof(Slot);
+    hdr->head.store(0, std::memory_order_relaxed);
+    for (uint64_t i = 0; i < slots; ++i) slot[i].seq.store(0, std::memory_order_relaxed);
+    hdr->epoch.fetch_add(1, std::memory_order_relaxed);
+    hdr->magic.store(MAGIC, std::memory_order_release);
+    mask = slots - 1;
+    writer = true;
+    return true;
+  }
+
+  /**
+   * - Reader: attach read-only to an existing ring
+   * - from_oldest : start at the oldest retained sample instead of "now"
+   */
+  bool open(const char *name, bool from_oldest = false) {
+    close();
+    const int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(Header)) {
+      ::close(fd);
+      return false;
+    }
+    if (!map(fd, (size_t)st.st_size, PROT_READ)) return false;
+    if (hdr->magic.load(std::memory_order_acquire) != MAGIC || hdr->slotSize != sizeof(Slot) ||
+        (hdr->slots & (hdr->slots - 1)) || sizeof(Header) + hdr->slots * sizeof(Slot) > len) {
+      close();
+      return false;
+    }
+    mask = hdr->slots - 1;
+    epoch = hdr->epoch.load(std::memory_order_relaxed);
+    const uint64_t h = hdr->head.load(std::memory_order_acquire);
+    cursor = (from_oldest && h > hdr->slots) ? h - hdr->slots : (from_oldest ? 0 : h);
+    return true;
+  }
+
+  void close() {
+    if (base) munmap(base, len);
+    base = nullptr;
+    hdr = nullptr;
+    slot = nullptr;
+    len = 0;
+    writer = false;
+  }
+
+  bool isOpen() const { return base != nullptr; }
+  uint64_t capacity() const { return mask + 1; }
+
+  // ---------------- writer ----------------
+
+  /** - Publish one sample (single writer, wait-free) */
+  void publish(const Scd4xShmSample &s) {
+    const uint64_t n = hdr->head.load(std::memory_order_relaxed);
+    Slot &sl = slot[n & mask];
+    sl.seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy((void *)&sl.data, &s, sizeof(s));
+    sl.seq.store(2 * n + 2, std::memory_order_release);
+    hdr->head.store(n + 1, std::memory_order_release);
+  }
+
+  // ---------------- reader ----------------
+
+  /**
+   * - Take the next sample
+   * - EMPTY   : nothing new
+   * - OK      : out holds the next sample
+   * - OVERRUN : samples were lost (see lost()); out holds the oldest
+   *             retained one
+   */
+  Result poll(Scd4xShmSample &out) {
+    bool skipped = false;
+    for (;;) {
+      const uint64_t h = hdr->head.load(std::memory_order_acquire);
+      if (hdr->epoch.load(std::memory_order_relaxed) != epoch) {
+        // Writer re-created the ring: restart from its current head
+        epoch = hdr->epoch.load(std::memory_order_relaxed);
+        cursor = h;
+        return EMPTY;
+      }
+      if (cursor >= h) return EMPTY;
+      if (h - cursor > capacity()) {
+        nLost += h - capacity() - cursor;
+        cursor = h - capacity();
+        skipped = true;
+      }
+      const Slot &sl = slot[cursor & mask];
+      const uint64_t want = 2 * cursor + 2;
+      const uint64_t s1 = sl.seq.load(std::memory_order_acquire);
+      memcpy(&out, (const void *)&sl.data, sizeof(out));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      const uint64_t s2 = sl.seq.load(std::memory_order_relaxed);
+      if (s1 == want && s2 == want) {
+        ++cursor;
+        return skipped ? OVERRUN : OK;
+      }
+      if (s1 < want && s2 < want) return EMPTY;  // ring reset under us
+      // Lapped while copying: re-read head and skip forward
+      skipped = true;
+      if (s1 > want || s2 > want) {
+        const uint64_t h2 = hdr->head.load(std::memory_order_acquire);
+        const uint64_t oldest = h2 > capacity() ? h2 - capacity() + 1 : 0;
+        if (oldest > cursor) {
+          nLost += oldest - cursor;
+          cursor = oldest;
+        }
+      }
+    }
+  }
+
+  /** - Samples this reader missed through overruns */
+  uint64_t lost() const { return nLost; }
+  /** - Samples published but not yet taken by this reader */
+  uint64_t backlog() const { return hdr->head.load(std::memory_order_acquire) - cursor; }
+
+private:
+  static const uint64_t MAGIC = 0x53344652494E4731ULL;  // "S4FRING1"
+
+  struct alignas(64) Header {
+    std::atomic<uint64_t> magic;
+    std::atomic<uint64_t> epoch;
+    uint64_t slots;
+    uint64_t slotSize;
+    alignas(64) std::atomic<uint64_t> head;  // own line: the only hot shared word
+  };
+
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> seq;
+    Scd4xShmSample data;
+  };
+
+  void *base = nullptr;
+  size_t len = 0;
+  Header *hdr = nullptr;
+  Slot *slot = nullptr;
+  uint64_t mask = 0;
+  bool writer = false;
+
+  uint64_t cursor = 0;
+  uint64_t epoch = 0;
+  uint64_t nLost = 0;
+
+  bool map(int fd, size_t bytes, int prot) {
+    base = mmap(nullptr, bytes, prot, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+      base = nullptr;
+      return false;
+    }
+    len = bytes;
+    hdr = (Header *)base;
+    slot = (Slot *)((uint8_t *)base + sizeof(Header));
+    return true;
+  }
+};
+
+#endif  // _7Semi_SCD4X_SHM_RING_H
@@ -0,0 +1,106 @@
+#ifndef _7Semi_SCD4X_WORK_POOL_H
+#define _7Semi_SCD4X_WORK_POOL_H
+
+/**
+ * scd4x_work_pool.h
+ * -----------------
+ * Host-only work-stealing thread pool for batch jobs over log files
+ *
+ * Model
+ * -----
+ * - run(n, f) executes f(task, worker) for task = 0..n−1.
+ * - Tasks are dealt to workers in contiguous ranges (neighbouring blocks of
+ *   one file stay on one core). A worker pops from the back of its own
+ *   deque; when empty it steals from the front of the others, so the
+ *   victim keeps its cache-warm tail.
+ * - One mutex per deque: tasks here are whole block ranges (milliseconds of
+ *   work), so lock cost is noise and a lock-free deque buys nothing.
+ *
+ * Notes
+ * -----
+ * - Threads live for one run(); steals() reports how much balancing was
+ *   needed.
+ */
+
+#include <stddef.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Scd4xWorkPool {
+public:
+  /** - threads : worker count (0 = hardware concurrency) */
+  explicit Scd4xWorkPool(unsigned threads = 0) {
+    n = threads ? threads : std::thread::hardware_concurrency();
+    if (n == 0) n = 1;
+  }
+
+  unsigned threads() const { return n; }
+  /** - Tasks taken from another worker during the last run() */
+  size_t steals() const { return nSteals.load(); }
+
+  /**
+   * - Run f(task_index, worker_index) for every task, return when all done
+   * - f must be safe to call concurrently for different tasks
+   */
+  template <class F>
+  void run(size_t tasks, F &&f) {
+    std::vector<Queue> q(n);
+    for (unsigned w = 0; w < n; ++w) {
+      const size_t lo = tasks * w / n, hi = tasks * (w + 1) / n;
+      for (size_t t = lo; t < hi; ++t) q[w].d.push_back(t);
+    }
+    nSteals = 0;
+
+    auto worker = [&](unsigned w) {
+      size_t t;
+      for (;;) {
+        if (pop(q[w], t)) {
+          f(t, w);
+          continue;
+        }
+        bool got = false;
+        for (unsigned k = 1; k < n && !got; ++k)
+          got = steal(q[(w + k) % n], t);
+        if (!got) return;  // nothing is ever re-queued, so empty everywhere = done
+        ++nSteals;
+        f(t, w);
+      }
+    };
+
+    std::vector<std::thread> th;
+    for (unsigned w = 1; w < n; ++w) th.emplace_back(worker, w);
+    worker(0);
+    for (std::thread &t : th) t.join();
+  }
+
+private:
+  struct Queue {
+    std::mutex m;
+    std::deque<size_t> d;
+  };
+
+  unsigned n;
+  std::atomic<size_t> nSteals{ 0 };
+
+  static bool pop(Queue &q, size_t &t) {
+    std::lock_guard<std::mutex> l(q.m);
+    if (q.d.empty()) return false;
+    t = q.d.back();
+    q.d.pop_back();
+    return true;
+  }
+
+  static bool steal(Queue &q, size_t &t) {
+    std::lock_guard<std::mutex> l(q.m);
+    if (q.d.empty()) return false;
+    t = q.d.front();
+    q.d.pop_front();
+    return true;
+  }
+};
+
+#endif  // _7Semi_SCD4X_WORK_POOL_H
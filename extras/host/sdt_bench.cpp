@@ -0,0 +1,108 @@
+/**
+ * sdt_bench.cpp
+ * -------------
+ * Host benchmark: SDT compression ratio and reconstruction error on
+ * simulated office data (extras/host/scd4x_office_sim.h)
+ *
+ * Build / run
+ * -----------
+ *   g++ -O2 -std=c++17 -I../../src sdt_bench.cpp ../../src/7Semi_SCD4x_Sdt.cpp -o sdt_bench
+ *   ./sdt_bench [days] [co2_E_ppm] [t_E_0.01C] [rh_E_0.01%]
+ *
+ * Output
+ * ------
+ * - Per channel: points kept, ratio, max |error| vs bound, bytes
+ *   (8 B per archived point; raw = 3 × 2 B words + 4 B timestamp per sample).
+ * - The same series is run twice: from t = 0, and shifted so it crosses
+ *   the uint32 millis() wrap halfway; both must stay within the bound.
+ *
+ * Typical (7 days, seed 42): E = 15 ppm / 0.05 °C / 0.2 %RH → ~3.6x overall;
+ * E = 30 ppm / 0.1 °C / 0.5 %RH over 30 days → ~35x. CO₂ sensor noise
+ * (≈ ±10 ppm) dominates at tight bounds.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "7Semi_SCD4x_Sdt.h"
+#include "scd4x_office_sim.h"
+
+struct Channel {
+  const char *name;
+  SCD4x_Sdt_7Semi sdt;
+  std::vector<SCD4x_SdtPoint_7Semi> pts;
+  std::vector<int32_t> truth;
+  int32_t bound;
+};
+
+/**
+ * - Compress and reconstruct the three channels with timestamps shifted by t0
+ * - return : true if every channel stayed within its bound
+ */
+static bool run(const char *label, uint32_t t0, int days, const int32_t *bounds) {
+  Channel ch[3] = {
+    { "CO2 (ppm)",  SCD4x_Sdt_7Semi(bounds[0]), {}, {}, bounds[0] },
+    { "T (0.01C)",  SCD4x_Sdt_7Semi(bounds[1]), {}, {}, bounds[1] },
+    { "RH (0.01%)", SCD4x_Sdt_7Semi(bounds[2]), {}, {}, bounds[2] },
+  };
+
+  Scd4xOfficeSim sim(42);
+  const size_t n = (size_t)days * 86400 / 5;
+  std::vector<uint32_t> ts(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    Scd4xSimSample s = sim.next();
+    ts[i] = s.t_ms + t0;
+    const int32_t v[3] = { s.co2_ppm, s.temp_c, s.rh_c };
+    for (int k = 0; k < 3; ++k) {
+      SCD4x_SdtPoint_7Semi p;
+      ch[k].truth.push_back(v[k]);
+      if (ch[k].sdt.add(ts[i], v[k], p)) ch[k].pts.push_back(p);
+    }
+  }
+
+  printf("%s: %d day(s), %zu samples per channel @5 s, t0 = %lu ms%s\n", label, days, n, (unsigned long)t0,
+         ts[n - 1] < ts[0] ? " (crosses the wrap)" : "");
+  printf("%-11s %6s %8s %8s %7s %7s\n", "channel", "E", "points", "ratio", "maxerr", "bytes");
+  size_t total = 0;
+  bool ok = true;
+  for (Channel &c : ch) {
+    SCD4x_SdtPoint_7Semi p;
+    if (c.sdt.flush(p)) c.pts.push_back(p);
+
+    std::vector<int32_t> rec(n);
+    SCD4x_Sdt_7Semi::decompress(c.pts.data(), c.pts.size(), ts.data(), rec.data(), n);
+    int32_t maxErr = 0;
+    for (size_t i = 0; i < n; ++i) {
+      int32_t e = abs(rec[i] - c.truth[i]);
+      if (e > maxErr) maxErr = e;
+      // Spot-check the binary-search decoder on the same timestamps
+      if (i % 97 == 0) {
+        e = abs(SCD4x_Sdt_7Semi::interpolate(c.pts.data(), c.pts.size(), ts[i]) - c.truth[i]);
+        if (e > maxErr) maxErr = e;
+      }
+    }
+    const size_t bytes = c.pts.size() * sizeof(SCD4x_SdtPoint_7Semi);
+    total += bytes;
+    ok &= maxErr <= c.bound;
+    printf("%-11s %6d %8zu %7.1fx %7d %7zu%s\n", c.name, c.bound, c.pts.size(),
+           (double)n / c.pts.size(), maxErr, bytes, maxErr > c.bound ? "  BOUND EXCEEDED" : "");
+  }
+  const size_t raw = n * (3 * 2 + 4);
+  printf("raw %zu B -> SDT %zu B (%.1fx)\n\n", raw, total, (double)raw / total);
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  const int days = (argc > 1) ? atoi(argv[1]) : 7;
+  const int32_t bounds[3] = {
+    (argc > 2) ? atoi(argv[2]) : 15,
+    (argc > 3) ? atoi(argv[3]) : 5,
+    (argc > 4) ? atoi(argv[4]) : 20,
+  };
+  const uint32_t span = (uint32_t)days * 86400000UL;
+  bool ok = run("from 0", 0, days, bounds);
+  ok &= run("wrapped", (uint32_t)0 - span / 2, days, bounds);
+  return ok ? 0 : 1;
+}
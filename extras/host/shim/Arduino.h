@@ -0,0 +1,44 @@
+#ifndef _7Semi_SCD4X_SHIM_ARDUINO_H
+#define _7Semi_SCD4X_SHIM_ARDUINO_H
+
+/**
+ * shim/Arduino.h
+ * --------------
+ * Minimal Arduino API for building the driver on Linux (host tools only)
+ *
+ * Notes
+ * -----
+ * - Provides the timing calls the driver uses; delay() really sleeps, so
+ *   only setup paths should go through blocking driver calls.
+ * - ARDUINO is deliberately left undefined: portable headers keep their
+ *   host branches.
+ */
+
+#include <math.h>
+#include <sched.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+inline unsigned long micros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long)((uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000);
+}
+
+inline unsigned long millis() { return (unsigned long)(micros() / 1000); }
+
+inline void delayMicroseconds(unsigned int us) {
+  struct timespec ts = { (time_t)(us / 1000000), (long)(us % 1000000) * 1000 };
+  nanosleep(&ts, nullptr);
+}
+
+inline void delay(unsigned long ms) {
+  struct timespec ts = { (time_t)(ms / 1000), (long)(ms % 1000) * 1000000L };
+  nanosleep(&ts, nullptr);
+}
+
+inline void yield() { sched_yield(); }
+
+#endif  // _7Semi_SCD4X_SHIM_ARDUINO_H
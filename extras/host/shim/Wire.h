@@ -0,0 +1,60 @@
+#ifndef _7Semi_SCD4X_SHIM_WIRE_H
+#define _7Semi_SCD4X_SHIM_WIRE_H
+
+/**
+ * shim/Wire.h
+ * -----------
+ * TwoWire over an Scd4xI2cPort, so SCD4x_7Semi runs unchanged on Linux
+ *
+ * Notes
+ * -----
+ * - beginTransmission / write / endTransmission buffer one write transfer;
+ *   requestFrom performs one read transfer into the receive buffer.
+ * - endTransmission() returns 0 on success and 2 (address NACK) otherwise,
+ *   as the Arduino core does.
+ * - The global Wire is unbound; pass a TwoWire bound to a port instead.
+ */
+
+#include "Arduino.h"
+#include "../scd4x_i2c_bus.h"
+
+class TwoWire {
+public:
+  TwoWire() {}
+  explicit TwoWire(const Scd4xI2cPort &p) : port(p) {}
+
+  void begin() {}
+  void setClock(uint32_t) {}
+
+  void beginTransmission(uint8_t addr) {
+    txAddr = addr;
+    txLen = 0;
+  }
+  size_t write(uint8_t b) {
+    if (txLen >= sizeof(tx)) return 0;
+    tx[txLen++] = b;
+    return 1;
+  }
+  uint8_t endTransmission(bool = true) { return port.write(txAddr, tx, txLen) ? 0 : 2; }
+
+  uint8_t requestFrom(uint8_t addr, uint8_t n) {
+    rxLen = rxPos = 0;
+    if (n > sizeof(rx) || !port.read(addr, rx, n)) return 0;
+    rxLen = n;
+    return n;
+  }
+  int available() const { return (int)(rxLen - rxPos); }
+  int read() { return rxPos < rxLen ? rx[rxPos++] : -1; }
+
+  Scd4xI2cPort port;
+
+private:
+  uint8_t tx[32];
+  uint8_t rx[32];
+  uint8_t txAddr = 0;
+  size_t  txLen = 0, rxLen = 0, rxPos = 0;
+};
+
+inline TwoWire Wire;
+
+#endif  // _7Semi_SCD4X_SHIM_WIRE_H
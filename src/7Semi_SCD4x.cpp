@@ -27,6 +27,16 @@
  * - State dependencies (per Sensirion guidance):
  *     * Set temperature offset / altitude / pressure **only while idle** (not measuring).
  *     * After changing compensation, you may persist (NVM) and reInit() to reload.
+ * - Shared bus (setArbiter()):
+ *     * Each command + response becomes one SCD4x_BusArbiter_7Semi unit; the
+ *       same waits as the direct path, spent off the bus. Forced recalibration
+ *       and self-test run as single units (500 ms / 10 s).
+ * - Profiles (setProfileStore()):
+ *     * begin() restores the stored profile for the serial it just read;
+ *       only differing settings are written, so a provisioned sensor
+ *       costs a few reads and no NVM write.
+ *     * setProfileStore() lives in 7Semi_SCD4x_Profile.cpp and installs the
+ *       restore hook, so sketches without profiles never link that code.
  * - Error handling:
  *     * Functions return `false` on I²C errors or CRC mismatch; no exceptions, no dynamic allocation.
  *
@@ -88,8 +98,9 @@ bool SCD4x_7Semi::begin(uint8_t i2cAddr, int sda, int scl, uint32_t i2cFreq) {
   delay(5); // small delay to let sensor stop
   // Presence check via serial number
   uint64_t sn;
-  if (readSerialNumber(sn)) return true;
-  return false;
+  if (!readSerialNumber(sn)) return false;
+  if (profileRestore) profileRestore(profileStore, *this, sn);
+  return true;
 }
 
 // ================ Measurement Control ================
@@ -133,6 +144,31 @@ bool SCD4x_7Semi::getDataReadyStatus(uint16_t &status_raw) {
 - return     : true on success (CRC + length OK)
 */
 bool SCD4x_7Semi::readMeasurement(uint16_t &co2_ppm, float &temp_c, float &rh_percent) {
+  uint16_t co2_raw, t_raw, rh_raw;
+  if (!readMeasurementRaw(co2_raw, t_raw, rh_raw)) return false;
+
+  co2_ppm   = co2_raw;
+  temp_c    = -45.0f + 175.0f * (float)t_raw / 65535.0f;
+  rh_percent= 100.0f * (float)rh_raw / 65535.0f;
+  return true;
+}
+
+/**
+- Read latest sample as raw words
+- co2_raw, t_raw, rh_raw : out words exactly as sent by the sensor
+- return : true on success (CRC + length OK)
+*/
+bool SCD4x_7Semi::readMeasurementRaw(uint16_t &co2_raw, uint16_t &t_raw, uint16_t &rh_raw) {
+#if defined(SCD4X_BUS_ARBITER)
+  if (arbiter) {
+    uint16_t w[3];
+    if (!busTransact(READ_MEASUREMENT_RAW_CMD_ID, nullptr, 0, 5000, w, 3)) return false;
+    co2_raw = w[0];
+    t_raw = w[1];
+    rh_raw = w[2];
+    return true;
+  }
+#endif
   if (!sendCommand(READ_MEASUREMENT_RAW_CMD_ID)) return false;
   delay(5); // Allow time for data to be ready
 
@@ -143,14 +179,9 @@ bool SCD4x_7Semi::readMeasurement(uint16_t &co2_ppm, float &temp_c, float &rh_pe
   for (size_t i = 0; i < 9; ++i)
     raw[i] = i2c->read();
 
-  uint16_t co2_raw, t_raw, rh_raw;
   if (!checkCrc(raw + 0, co2_raw)) return false;
   if (!checkCrc(raw + 3, t_raw))   return false;
   if (!checkCrc(raw + 6, rh_raw))  return false;
-
-  co2_ppm   = co2_raw;
-  temp_c    = -45.0f + 175.0f * (float)t_raw / 65535.0f;
-  rh_percent= 100.0f * (float)rh_raw / 65535.0f;
   return true;
 }
 
@@ -190,6 +221,17 @@ bool SCD4x_7Semi::getTemperatureOffset(float &degC) {
   return true;
 }
 
+/**
+- Set / get temperature offset word as stored by the sensor
+*/
+bool SCD4x_7Semi::setTemperatureOffsetRaw(uint16_t raw) {
+  return writeCommand(SET_TEMPERATURE_OFFSET_RAW_CMD_ID, &raw, 1);
+}
+
+bool SCD4x_7Semi::getTemperatureOffsetRaw(uint16_t &raw) {
+  return readNData(GET_TEMPERATURE_OFFSET_RAW_CMD_ID, &raw, 1);
+}
+
 /**
 - Set installation altitude (meters)
 */
@@ -288,6 +330,11 @@ bool SCD4x_7Semi::getAutomaticSelfCalibrationStandardPeriod(uint16_t &hours) {
 - frc_result    : optional device return value
 */
 bool SCD4x_7Semi::performForcedRecalibration(uint16_t reference_ppm, uint16_t *frc_result) {
+#if defined(SCD4X_BUS_ARBITER)
+  if (arbiter)
+    return busTransact(PERFORM_FORCED_RECALIBRATION_CMD_ID, &reference_ppm, 1, frc_result ? 500000UL : 0,
+                       frc_result, frc_result ? 1 : 0);
+#endif
   if (!writeCommand(PERFORM_FORCED_RECALIBRATION_CMD_ID, &reference_ppm, 1)) return false;
   if (frc_result) {
     delay(500); // Allow time for recalibration
@@ -310,6 +357,14 @@ bool SCD4x_7Semi::persistSettings() {
 - sn : out 48-bit serial (w0|w1|w2)
 */
 bool SCD4x_7Semi::readSerialNumber(uint64_t &sn) {
+#if defined(SCD4X_BUS_ARBITER)
+  if (arbiter) {
+    uint16_t w[3];
+    if (!busTransact(GET_SERIAL_NUMBER_CMD_ID, nullptr, 0, 5000, w, 3)) return false;
+    sn = ((uint64_t)w[0] << 32) | ((uint64_t)w[1] << 16) | (uint64_t)w[2];
+    return true;
+  }
+#endif
   if (!sendCommand(GET_SERIAL_NUMBER_CMD_ID)) return false;
   delay(5);
   uint8_t raw[9];
@@ -338,6 +393,9 @@ bool SCD4x_7Semi::getSensorVariantRaw(uint16_t &variant) {
 - Run self-test (blocking); returns a status word
 */
 bool SCD4x_7Semi::performSelfTest(uint16_t &status_word) {
+#if defined(SCD4X_BUS_ARBITER)
+  if (arbiter) return busTransact(PERFORM_SELF_TEST_CMD_ID, nullptr, 0, 10000000UL, &status_word, 1);
+#endif
   return readNData(PERFORM_SELF_TEST_CMD_ID, &status_word, 1);
 }
 
@@ -371,6 +429,41 @@ bool SCD4x_7Semi::wakeUp() {
   return sendCommand(WAKE_UP_CMD_ID);
 }
 
+#if defined(SCD4X_BUS_ARBITER)
+// ================= Shared bus =================
+
+/**
+- Route transactions through an arbiter (nullptr restores direct Wire)
+*/
+void SCD4x_7Semi::setArbiter(SCD4x_BusArbiter_7Semi *arb, uint8_t priority) {
+  arbiter = arb;
+  busPriority = priority;
+}
+
+/**
+- One command + response unit on the arbiter
+- words / nwords : command payload (≤ 2 words)
+- exec_us        : wait between write and read (off the bus)
+- out / nout     : response words (≤ 3), nout = 0 for write-only
+*/
+bool SCD4x_7Semi::busTransact(uint16_t cmd, const uint16_t *words, size_t nwords, uint32_t exec_us, uint16_t *out,
+                              size_t nout) {
+  if (nwords > 2 || nout > 3) return false;
+  uint8_t tx[8];
+  uint8_t rx[9];
+  SCD4x_BusUnit_7Semi u{};
+  u.address = address;
+  u.priority = busPriority;
+  u.tx = tx;
+  u.txLen = SCD4x_BusArbiter_7Semi::frameCommand(tx, cmd, words, (uint8_t)nwords);
+  u.rx = nout ? rx : nullptr;
+  u.rxLen = (uint16_t)(nout * 3);
+  u.execUs = exec_us;
+  if (!arbiter->transact(u)) return false;
+  return !nout || SCD4x_BusArbiter_7Semi::unpackWords(rx, out, (uint8_t)nout);
+}
+#endif
+
 // ================= Low-level helpers =================
 
 /**
@@ -411,6 +504,9 @@ bool SCD4x_7Semi::writeCommand(uint16_t cmd, const uint16_t *words, size_t nword
 - return : true when length and CRCs match
 */
 bool SCD4x_7Semi::readNData(uint16_t cmd, uint16_t *out, size_t nwords) {
+#if defined(SCD4X_BUS_ARBITER)
+  if (arbiter) return busTransact(cmd, nullptr, 0, 1000, out, nwords);
+#endif
   if (!sendCommand(cmd)) return false;
   delay(1);
 
@@ -441,6 +537,9 @@ bool SCD4x_7Semi::readNData(uint16_t cmd, uint16_t *out, size_t nwords) {
 - return : true if endTransmission() == 0
 */
 bool SCD4x_7Semi::txCommand(uint16_t cmd, const uint16_t *words, size_t nwords) {
+#if defined(SCD4X_BUS_ARBITER)
+  if (arbiter) return busTransact(cmd, words, nwords, 0, nullptr, 0);
+#endif
   i2c->beginTransmission(address);
   i2c->write(uint8_t(cmd >> 8));   // MSB
   i2c->write(uint8_t(cmd & 0xFF)); // LSB
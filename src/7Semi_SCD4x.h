@@ -3,6 +3,9 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include "7Semi_SCD4x_Bus.h"
+
+class SCD4x_ProfileStore_7Semi;
 
 /**
  * 7Semi_SCD4x.h
@@ -22,6 +25,9 @@
  * - Persist settings (NVM), read serial number & variant, self-test
  * - Power control: wake / power-down
  * - Flexible I²C: optional pin remap on ESP32/ESP8266; alternate TwoWire bus
+ * - Shared bus (ESP32 / host): optional SCD4x_BusArbiter_7Semi so command +
+ *   response never interleave with other tasks' devices on the same Wire
+ * - Per-serial profile restore in begin() (SCD4x_ProfileStore_7Semi)
  *
  * Notes
  * -----
@@ -103,6 +109,13 @@ public:
    * - rh_percent : out %RH (RH = 100 * raw / 65535)
    */
   bool readMeasurement(uint16_t &co2_ppm, float &temp_c, float &rh_percent);
+  /**
+   * - Read latest sample as raw words (CRC-checked, not converted)
+   * - co2_raw : out CO₂ word (= ppm)
+   * - t_raw   : out temperature word
+   * - rh_raw  : out humidity word
+   */
+  bool readMeasurementRaw(uint16_t &co2_raw, uint16_t &t_raw, uint16_t &rh_raw);
   /** - Trigger single-shot CO₂+RHT measurement (no read here) */
   bool measureSingleShot();
   /** - Trigger single-shot RHT-only measurement */
@@ -113,6 +126,10 @@ public:
   bool setTemperatureOffset(float degC);
   /** - Get temperature offset in °C */
   bool getTemperatureOffset(float &degC);
+  /** - Set temperature offset word (°C = 175 · raw / 65535) */
+  bool setTemperatureOffsetRaw(uint16_t raw);
+  /** - Get temperature offset word (exact, for compare-before-write) */
+  bool getTemperatureOffsetRaw(uint16_t &raw);
   /** - Set installation altitude in meters */
   bool setSensorAltitude(uint16_t meters);
   /** - Get installation altitude in meters */
@@ -160,10 +177,41 @@ public:
   /** - Wake from low-power mode */
   bool wakeUp();
 
+  // ----------------------- Profiles -----------------------
+  /**
+   * - Restore this sensor's profile from store in begin() (nullptr = off)
+   * - Call before begin(); see SCD4x_ProfileStore_7Semi::restore()
+   * - Defined in 7Semi_SCD4x_Profile.cpp (include 7Semi_SCD4x_Profile.h)
+   */
+  void setProfileStore(SCD4x_ProfileStore_7Semi *store);
+
+#if defined(SCD4X_BUS_ARBITER)
+  // ------------------------ Shared bus ------------------------
+  /**
+   * - Route every transaction through a bus arbiter (nullptr = direct Wire)
+   * - priority : arbiter priority of this sensor's units
+   * - Call after begin(); the calling task then blocks only for its own
+   *   units, and command execution times leave the bus to other devices
+   */
+  void setArbiter(SCD4x_BusArbiter_7Semi *arb, uint8_t priority = 1);
+#endif
+
 private:
   // I²C handle and fixed device address (0x62)
   TwoWire *i2c;
   uint8_t address = 0x62;
+  SCD4x_ProfileStore_7Semi *profileStore = nullptr;
+  // Set by setProfileStore() (7Semi_SCD4x_Profile.cpp); begin() calls it
+  uint8_t (*profileRestore)(SCD4x_ProfileStore_7Semi *, SCD4x_7Semi &, uint64_t) = nullptr;
+#if defined(SCD4X_BUS_ARBITER)
+  SCD4x_BusArbiter_7Semi *arbiter = nullptr;
+  uint8_t busPriority = 1;
+  /**
+   * - One arbitrated unit: command + words, wait exec_us, read nout words
+   * - return : true on bus OK and all CRCs valid
+   */
+  bool busTransact(uint16_t cmd, const uint16_t *words, size_t nwords, uint32_t exec_us, uint16_t *out, size_t nout);
+#endif
 
   // --------------- Low-level primitives ---------------
   /** - Sensirion CRC-8 (poly 0x31, init 0xFF) for one 16-bit word */
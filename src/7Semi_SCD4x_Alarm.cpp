@@ -0,0 +1,174 @@
+/**
+ * 7Semi_SCD4x_Alarm.cpp
+ * ---------------------
+ * Incremental threshold rules with hysteresis and hold-count debounce
+ *
+ * Implementation Notes
+ * --------------------
+ * - Each rule keeps one counter and one flag; counter restarts whenever the
+ *   pending condition (enter while idle, exit while active) is not met.
+ * - Mode switching needs stopPeriodicMeasurement() + 500 ms before restart
+ *   (per Sensirion guidance); this happens only on the first enter and
+ *   the last exit, never on every sample.
+ * - The switch is a small state machine (stop → wait → start) advanced by
+ *   poll(), with the wait held in busyUntilMs as in SCD4x_Queue_7Semi.
+ *   A request that flips back before the stop is sent is dropped; one
+ *   that flips while stopped only changes which start is issued.
+ * - If the sketch already runs standard periodic, alarms never switch.
+ * - millis() wraps every ~49 days; comparisons use signed differences.
+ */
+
+#include "7Semi_SCD4x_Alarm.h"
+
+#define SCD4X_ALARM_STOP_MS  500  // stop_periodic_measurement execution time
+
+/**
+- Bind engine to rule table
+*/
+SCD4x_Alarm_7Semi::SCD4x_Alarm_7Semi(SCD4x_AlarmRule_7Semi *r, uint8_t n, SCD4x_AlarmCallback_7Semi cb)
+  : rules(r), nrules(r ? n : 0), callback(cb) {
+  reset();
+}
+
+void SCD4x_Alarm_7Semi::onEvent(SCD4x_AlarmCallback_7Semi cb) { callback = cb; }
+
+/**
+- Attach driver; low_power is the mode it is measuring in now
+*/
+void SCD4x_Alarm_7Semi::attachSensor(SCD4x_7Semi *s, bool low_power) {
+  sensor = s;
+  baseLowPower = runLowPower = low_power;
+  wantLowPower = (nactive > 0) ? false : low_power;
+  phase = (wantLowPower != runLowPower) ? PH_STOP : PH_IDLE;
+  errors = 0;
+  busyUntilMs = millis();
+  poll();
+}
+
+/**
+- Evaluate rules on a float sample (converted to integer channel units)
+*/
+uint8_t SCD4x_Alarm_7Semi::update(uint16_t co2_ppm, float temp_c, float rh_percent) {
+  int16_t t = (int16_t)(temp_c * 100.0f + (temp_c >= 0.0f ? 0.5f : -0.5f));
+  uint16_t rh = (uint16_t)(rh_percent * 100.0f + 0.5f);
+  return updateFixed(co2_ppm, t, rh);
+}
+
+/**
+- Evaluate rules on an integer sample
+- return : active alarm count
+*/
+uint8_t SCD4x_Alarm_7Semi::updateFixed(uint16_t co2_ppm, int16_t temp_c, uint16_t rh_c) {
+  const uint8_t before = nactive;
+  for (uint8_t i = 0; i < nrules; ++i) {
+    SCD4x_AlarmRule_7Semi &r = rules[i];
+    int32_t v;
+    switch (r.channel) {
+      case CO2:         v = co2_ppm; break;
+      case TEMPERATURE: v = temp_c;  break;
+      case HUMIDITY:    v = rh_c;    break;
+      default:          continue;
+    }
+    if (!step(r, v)) continue;
+    if (r.active) ++nactive;
+    else --nactive;
+    if (callback) callback(i, r.active, v);
+  }
+
+  if (before == 0 && nactive > 0) applyMode(true);
+  else if (before > 0 && nactive == 0) applyMode(false);
+  return nactive;
+}
+
+uint8_t SCD4x_Alarm_7Semi::activeCount() const { return nactive; }
+
+bool SCD4x_Alarm_7Semi::isActive(uint8_t i) const {
+  return (i < nrules) && rules[i].active;
+}
+
+void SCD4x_Alarm_7Semi::reset() {
+  for (uint8_t i = 0; i < nrules; ++i) {
+    rules[i].count = 0;
+    rules[i].active = false;
+  }
+  if (nactive > 0) applyMode(false);
+  nactive = 0;
+}
+
+// ================= Helpers =================
+
+/**
+- Step one rule
+- return : true if active state changed
+*/
+bool SCD4x_Alarm_7Semi::step(SCD4x_AlarmRule_7Semi &r, int32_t value) {
+  const bool above = (r.comparator == ABOVE);
+  bool pending;
+  if (!r.active) {
+    pending = above ? (value > r.threshold) : (value < r.threshold);
+  } else {
+    pending = above ? (value <= r.threshold - r.hysteresis)
+                    : (value >= r.threshold + r.hysteresis);
+  }
+
+  if (!pending) {
+    r.count = 0;
+    return false;
+  }
+  if (r.count < 255) ++r.count;
+  if (r.count < (r.hold ? r.hold : 1)) return false;
+
+  r.count = 0;
+  r.active = !r.active;
+  return true;
+}
+
+/**
+- Request measurement cadence
+- fast : true → standard periodic (5 s), false → mode given to attachSensor()
+*/
+void SCD4x_Alarm_7Semi::applyMode(bool fast) {
+  if (!sensor) return;
+  wantLowPower = fast ? false : baseLowPower;
+  if (phase == PH_IDLE) {
+    if (wantLowPower == runLowPower) return;
+    phase = PH_STOP;
+  }
+  poll();
+}
+
+// ================= Mode switch =================
+
+/**
+- Issue the next stop / start once the sensor is free
+*/
+void SCD4x_Alarm_7Semi::poll() {
+  if (!sensor || phase == PH_IDLE) return;
+  const uint32_t now = millis();
+  if ((int32_t)(now - busyUntilMs) < 0) return;
+
+  if (phase == PH_STOP) {
+    if (wantLowPower == runLowPower) {  // request flipped back in time
+      phase = PH_IDLE;
+      return;
+    }
+    if (!sensor->stopPeriodicMeasurement()) {
+      if (errors < 255) ++errors;
+      busyUntilMs = now + SCD4X_ALARM_STOP_MS;
+      return;
+    }
+    phase = PH_START;
+    busyUntilMs = now + SCD4X_ALARM_STOP_MS;
+    return;
+  }
+
+  const bool ok = wantLowPower ? sensor->startLowPowerPeriodicMeasurement()
+                               : sensor->startPeriodicMeasurement();
+  if (!ok) {
+    if (errors < 255) ++errors;
+    busyUntilMs = now + SCD4X_ALARM_STOP_MS;
+    return;
+  }
+  runLowPower = wantLowPower;
+  phase = PH_IDLE;
+}
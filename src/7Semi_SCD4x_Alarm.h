@@ -0,0 +1,125 @@
+#ifndef _7Semi_SCD4X_ALARM_H
+#define _7Semi_SCD4X_ALARM_H
+
+#include <Arduino.h>
+#include "7Semi_SCD4x.h"
+
+/**
+ * 7Semi_SCD4x_Alarm.h
+ * -------------------
+ * Threshold / alarm engine with hysteresis and debounce for SCD4x samples
+ *
+ * Usage
+ * -----
+ * - Declare a rule table (static array of SCD4x_AlarmRule_7Semi).
+ * - Call update() once per decoded sample; cost is O(1) per rule.
+ * - Enter / exit events are raised through one callback.
+ * - Optional: attachSensor() switches the sensor to standard periodic (5 s)
+ *   while any alarm is active and back to the mode the sketch started in
+ *   when clear. The switch is split-phase: update() issues the stop,
+ *   poll() issues the restart once the sensor's 500 ms stop time has
+ *   passed, so neither blocks.
+ *
+ * Rule semantics (ABOVE; BELOW is mirrored)
+ * -----------------------------------------
+ * - Enter : value >  threshold for `hold` consecutive samples
+ * - Exit  : value <= threshold - hysteresis for `hold` consecutive samples
+ *
+ * Units
+ * -----
+ * - CO2 : ppm, TEMPERATURE : 0.01 °C, HUMIDITY : 0.01 %RH
+ */
+
+/**
+ * - One alarm rule (configuration + 2 bytes of state)
+ * - Initialise with { channel, comparator, threshold, hysteresis, hold }
+ */
+struct SCD4x_AlarmRule_7Semi {
+  uint8_t channel;      // SCD4x_Alarm_7Semi::Channel
+  uint8_t comparator;   // SCD4x_Alarm_7Semi::Comparator
+  int32_t threshold;    // channel units
+  int32_t hysteresis;   // channel units (≥ 0)
+  uint8_t hold;         // consecutive samples to enter / exit (0 or 1 = immediate)
+  // ---- runtime state (zero-initialised) ----
+  uint8_t count;
+  bool    active;
+};
+
+/**
+ * - Alarm event callback
+ * - rule    : index into the rule table
+ * - entered : true on enter, false on exit
+ * - value   : channel value that triggered the transition
+ */
+typedef void (*SCD4x_AlarmCallback_7Semi)(uint8_t rule, bool entered, int32_t value);
+
+class SCD4x_Alarm_7Semi {
+public:
+  enum Channel : uint8_t { CO2 = 0, TEMPERATURE = 1, HUMIDITY = 2 };
+  enum Comparator : uint8_t { ABOVE = 0, BELOW = 1 };
+
+  /**
+   * - Bind engine to a caller-owned rule table
+   * - rules  : rule array (state lives inside)
+   * - nrules : number of rules
+   * - cb     : optional event callback
+   */
+  SCD4x_Alarm_7Semi(SCD4x_AlarmRule_7Semi *rules, uint8_t nrules, SCD4x_AlarmCallback_7Semi cb = nullptr);
+
+  /** - Set / replace event callback */
+  void onEvent(SCD4x_AlarmCallback_7Semi cb);
+  /**
+   * - Let alarm state drive the measurement mode
+   * - sensor    : driver (nullptr to detach); must already be in periodic mode
+   * - low_power : mode the sketch started (true = low-power periodic);
+   *               restored when the last alarm clears
+   */
+  void attachSensor(SCD4x_7Semi *sensor, bool low_power = true);
+  /**
+   * - Advance a pending mode switch; call from loop() (returns at once)
+   * - Failed stop / start commands are retried every 500 ms
+   */
+  void poll();
+  /** - True while the sensor is stopped or about to be restarted */
+  bool switching() const { return phase != PH_IDLE; }
+  /** - Failed stop / start commands since attachSensor() */
+  uint8_t modeErrors() const { return errors; }
+
+  /**
+   * - Evaluate all rules on one sample
+   * - co2_ppm, temp_c, rh_percent : as returned by readMeasurement()
+   * - return : number of active alarms after this sample
+   */
+  uint8_t update(uint16_t co2_ppm, float temp_c, float rh_percent);
+  /** - Same, with integer inputs (ppm, 0.01 °C, 0.01 %RH) */
+  uint8_t updateFixed(uint16_t co2_ppm, int16_t temp_c, uint16_t rh_c);
+
+  /** - Number of currently active alarms */
+  uint8_t activeCount() const;
+  /** - True if rule i is active */
+  bool isActive(uint8_t i) const;
+  /** - Clear all rule state (no events raised; mode returns to the attached one) */
+  void reset();
+
+private:
+  SCD4x_AlarmRule_7Semi *rules;
+  uint8_t nrules;
+  uint8_t nactive = 0;
+  SCD4x_AlarmCallback_7Semi callback;
+  SCD4x_7Semi *sensor = nullptr;
+
+  enum Phase : uint8_t { PH_IDLE = 0, PH_STOP, PH_START };
+  uint8_t phase = PH_IDLE;
+  bool baseLowPower = true;    // mode the sketch started
+  bool runLowPower = true;     // mode the sensor is measuring in
+  bool wantLowPower = true;    // mode requested by alarm state
+  uint8_t errors = 0;
+  uint32_t busyUntilMs = 0;
+
+  /** - Step one rule; return true on a state transition */
+  static bool step(SCD4x_AlarmRule_7Semi &r, int32_t value);
+  /** - Request standard periodic (fast) or the attached mode; see poll() */
+  void applyMode(bool fast);
+};
+
+#endif  // _7Semi_SCD4X_ALARM_H
@@ -0,0 +1,300 @@
+/**
+ * 7Semi_SCD4x_Bus.cpp
+ * -------------------
+ * Priority / deadline arbiter for one shared TwoWire
+ *
+ * Implementation Notes
+ * --------------------
+ * - Submissions land on a Treiber stack (one CAS per push). The arbiter
+ *   takes the whole stack with one exchange, so there is no ABA and no
+ *   lock between producers and the consumer; it reverses the batch to
+ *   keep submission order.
+ * - pending / waiting are intrusive lists owned by the arbiter task. Both
+ *   stay short (a handful of devices), so selection is a linear scan for
+ *   the best runnable unit instead of a heap.
+ * - A unit whose address has a unit in `waiting` is not runnable: that is
+ *   what keeps each device's command + response atomic.
+ * - micros() wraps every ~71 min; all comparisons use signed differences.
+ */
+
+#include "7Semi_SCD4x_Bus.h"
+
+#if defined(SCD4X_BUS_ARBITER)
+
+// ================= Setup =================
+
+SCD4x_BusArbiter_7Semi::SCD4x_BusArbiter_7Semi() : inbox(nullptr) {
+  memset(&st, 0, sizeof(st));
+}
+
+void SCD4x_BusArbiter_7Semi::begin(TwoWire *wire) { i2c = wire ? wire : &Wire; }
+
+// ================= Submission (any task) =================
+
+/**
+- Validate, stamp and push one unit; wakes the arbiter task
+*/
+bool SCD4x_BusArbiter_7Semi::submit(SCD4x_BusUnit_7Semi &u) {
+  if (!u.tx || u.txLen == 0 || (u.rxLen && !u.rx)) return false;
+  u.status.store(SCD4X_BUS_PENDING, std::memory_order_relaxed);
+  u.late = false;
+  u.submitUs = micros();
+  SCD4x_BusUnit_7Semi *head = inbox.load(std::memory_order_relaxed);
+  do {
+    u.next = head;
+  } while (!inbox.compare_exchange_weak(head, &u, std::memory_order_release, std::memory_order_relaxed));
+  wake();
+  return true;
+}
+
+/**
+- Submit, then wait for completion
+*/
+bool SCD4x_BusArbiter_7Semi::transact(SCD4x_BusUnit_7Semi &u, uint32_t timeout_ms) {
+  u.giveUpUs = timeout_ms ? micros() + timeout_ms * 1000UL : 0;
+  if (u.giveUpUs == 0 && timeout_ms) u.giveUpUs = 1;
+#if defined(ARDUINO_ARCH_ESP32)
+  u.waiter = task ? (void *)xTaskGetCurrentTaskHandle() : nullptr;
+#else
+  u.waiter = nullptr;
+#endif
+  if (!submit(u)) return false;
+  while (u.status.load(std::memory_order_acquire) == SCD4X_BUS_PENDING) {
+#if defined(ARDUINO_ARCH_ESP32)
+    if (task) {
+      ulTaskNotifyTake(pdFALSE, pdMS_TO_TICKS(10));  // status re-checked: tolerant of foreign notifications
+      continue;
+    }
+#endif
+    // No arbiter task: drive the scheduler from this (single) caller
+    const uint32_t w = poll();
+    if (w >= 1000) delay(1);
+    else if (w) yield();
+  }
+  return u.status.load(std::memory_order_acquire) == SCD4X_BUS_OK;
+}
+
+// ================= Scheduling (arbiter task) =================
+
+/**
+- Move the inbox into pending, oldest first
+*/
+void SCD4x_BusArbiter_7Semi::drain() {
+  SCD4x_BusUnit_7Semi *batch = inbox.exchange(nullptr, std::memory_order_acquire);
+  SCD4x_BusUnit_7Semi *fifo = nullptr;
+  while (batch) {
+    SCD4x_BusUnit_7Semi *n = batch->next;
+    batch->next = fifo;
+    fifo = batch;
+    batch = n;
+  }
+  while (fifo) {
+    SCD4x_BusUnit_7Semi *n = fifo->next;
+    fifo->seq = seq++;
+    fifo->next = pending;
+    pending = fifo;
+    fifo = n;
+  }
+  uint32_t depth = 0;
+  for (SCD4x_BusUnit_7Semi *p = pending; p; p = p->next) ++depth;
+  if (depth > st.maxPending) st.maxPending = depth;
+}
+
+/**
+- Ordering: priority desc, deadline asc (0 = none), submission asc
+*/
+bool SCD4x_BusArbiter_7Semi::before(const SCD4x_BusUnit_7Semi *a, const SCD4x_BusUnit_7Semi *b) const {
+  if (a->priority != b->priority) return a->priority > b->priority;
+  if (a->deadlineMs != b->deadlineMs) {
+    if (!a->deadlineMs) return false;
+    if (!b->deadlineMs) return true;
+    return (int32_t)(a->deadlineMs - b->deadlineMs) < 0;
+  }
+  return (int32_t)(a->seq - b->seq) < 0;
+}
+
+bool SCD4x_BusArbiter_7Semi::addressBusy(uint8_t address) const {
+  for (const SCD4x_BusUnit_7Semi *w = waiting; w; w = w->next)
+    if (w->address == address) return true;
+  return false;
+}
+
+/**
+- One step; returns µs until the next due read (UINT32_MAX when idle)
+*/
+uint32_t SCD4x_BusArbiter_7Semi::poll() {
+  if (!i2c) return UINT32_MAX;
+  drain();
+  uint32_t now = micros();
+
+  // 1) Responses whose execution time has elapsed
+  for (SCD4x_BusUnit_7Semi **pp = &waiting; *pp;) {
+    SCD4x_BusUnit_7Semi *w = *pp;
+    if ((int32_t)(now - w->readAtUs) >= 0) {
+      *pp = w->next;
+      finishRead(w);
+      now = micros();
+    } else {
+      pp = &w->next;
+    }
+  }
+
+  // 2) Best runnable unit (drop transact() units that waited too long)
+  SCD4x_BusUnit_7Semi **bestp = nullptr;
+  for (SCD4x_BusUnit_7Semi **pp = &pending; *pp;) {
+    SCD4x_BusUnit_7Semi *p = *pp;
+    if (p->giveUpUs && (int32_t)(now - p->giveUpUs) >= 0) {
+      *pp = p->next;
+      complete(p, SCD4X_BUS_TIMEOUT);
+      continue;
+    }
+    if (!addressBusy(p->address) && (!bestp || before(p, *bestp))) bestp = pp;
+    pp = &p->next;
+  }
+  if (bestp) {
+    SCD4x_BusUnit_7Semi *u = *bestp;
+    *bestp = u->next;
+    if (waiting) ++st.gapFills;
+    start(u);
+    return 0;
+  }
+
+  // 3) Idle until the earliest response (or a submission wakes us)
+  uint32_t wait = UINT32_MAX;
+  for (const SCD4x_BusUnit_7Semi *w = waiting; w; w = w->next) {
+    const int32_t d = (int32_t)(w->readAtUs - now);
+    const uint32_t du = d > 0 ? (uint32_t)d : 0;
+    if (du < wait) wait = du;
+  }
+  return wait;
+}
+
+/**
+- Write phase; a unit with an execution time parks in `waiting`
+*/
+void SCD4x_BusArbiter_7Semi::start(SCD4x_BusUnit_7Semi *u) {
+  const uint32_t now = micros();
+  u->queuedUs = now - u->submitUs;
+  if (u->queuedUs > st.maxQueuedUs) st.maxQueuedUs = u->queuedUs;
+
+  i2c->beginTransmission(u->address);
+  for (uint16_t i = 0; i < u->txLen; ++i) i2c->write(u->tx[i]);
+  if (i2c->endTransmission() != 0) {
+    complete(u, SCD4X_BUS_NACK);
+    return;
+  }
+  if (u->execUs == 0) {
+    finishRead(u);
+    return;
+  }
+  // Write-only units with an execution time still block their address
+  u->readAtUs = micros() + u->execUs;
+  u->next = waiting;
+  waiting = u;
+}
+
+/**
+- Read phase (no-op for write-only units)
+*/
+void SCD4x_BusArbiter_7Semi::finishRead(SCD4x_BusUnit_7Semi *u) {
+  if (u->rxLen) {
+    const uint8_t got = i2c->requestFrom(u->address, (uint8_t)u->rxLen);
+    if (got < u->rxLen || i2c->available() < (int)u->rxLen) {
+      while (i2c->available() > 0) (void)i2c->read();
+      complete(u, SCD4X_BUS_SHORT);
+      return;
+    }
+    for (uint16_t i = 0; i < u->rxLen; ++i) u->rx[i] = (uint8_t)i2c->read();
+  }
+  complete(u, SCD4X_BUS_OK);
+}
+
+/**
+- Publish the result; u belongs to its owner again after the status store
+*/
+void SCD4x_BusArbiter_7Semi::complete(SCD4x_BusUnit_7Semi *u, uint8_t status) {
+  u->totalUs = micros() - u->submitUs;
+  u->late = u->deadlineMs && (int32_t)(millis() - u->deadlineMs) > 0;
+  ++st.units;
+  if (status == SCD4X_BUS_NACK || status == SCD4X_BUS_SHORT) ++st.errors;
+  if (u->late) ++st.late;
+
+  SCD4x_BusDone_7Semi cb = u->done;
+  void *ctx = u->ctx;
+  void *waiter = u->waiter;
+  u->status.store(status, std::memory_order_release);
+  if (cb) cb(u, ctx);
+#if defined(ARDUINO_ARCH_ESP32)
+  if (waiter) xTaskNotifyGive((TaskHandle_t)waiter);
+#else
+  (void)waiter;
+#endif
+}
+
+// ================= Arbiter task (ESP32) =================
+
+#if defined(ARDUINO_ARCH_ESP32)
+void SCD4x_BusArbiter_7Semi::wake() {
+  if (task) xTaskNotifyGive((TaskHandle_t)task);
+}
+
+bool SCD4x_BusArbiter_7Semi::startTask(uint32_t stack_bytes, uint8_t priority, int core) {
+  if (task || !i2c) return false;
+  TaskHandle_t h = nullptr;
+  if (xTaskCreatePinnedToCore(taskMain, "scd4x_bus", stack_bytes, this, priority, &h, core) != pdPASS) return false;
+  task = h;
+  return true;
+}
+
+/**
+- poll() forever; sleep until the next response is due or a submit()
+*/
+void SCD4x_BusArbiter_7Semi::taskMain(void *self) {
+  SCD4x_BusArbiter_7Semi *a = (SCD4x_BusArbiter_7Semi *)self;
+  for (;;) {
+    const uint32_t w = a->poll();
+    if (w == 0) continue;
+    const TickType_t ticks = (w == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS((w + 999) / 1000);
+    ulTaskNotifyTake(pdTRUE, ticks ? ticks : 1);
+  }
+}
+#else
+void SCD4x_BusArbiter_7Semi::wake() {}
+#endif
+
+// ================= SCD4x framing =================
+
+/**
+- Command MSB/LSB, then each word as MSB, LSB, CRC
+*/
+uint16_t SCD4x_BusArbiter_7Semi::frameCommand(uint8_t *tx, uint16_t cmd, const uint16_t *words, uint8_t nwords) {
+  tx[0] = (uint8_t)(cmd >> 8);
+  tx[1] = (uint8_t)cmd;
+  uint16_t n = 2;
+  for (uint8_t i = 0; i < nwords; ++i) {
+    tx[n] = (uint8_t)(words[i] >> 8);
+    tx[n + 1] = (uint8_t)words[i];
+    tx[n + 2] = crc8(tx[n], tx[n + 1]);
+    n += 3;
+  }
+  return n;
+}
+
+bool SCD4x_BusArbiter_7Semi::unpackWords(const uint8_t *rx, uint16_t *out, uint8_t nwords) {
+  for (uint8_t i = 0; i < nwords; ++i, rx += 3) {
+    if (crc8(rx[0], rx[1]) != rx[2]) return false;
+    out[i] = (uint16_t)((uint16_t)rx[0] << 8 | rx[1]);
+  }
+  return true;
+}
+
+uint8_t SCD4x_BusArbiter_7Semi::crc8(uint8_t b0, uint8_t b1) {
+  uint8_t crc = 0xFF;
+  crc ^= b0;
+  for (int i = 0; i < 8; ++i) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+  crc ^= b1;
+  for (int i = 0; i < 8; ++i) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+  return crc;
+}
+
+#endif  // SCD4X_BUS_ARBITER
@@ -0,0 +1,185 @@
+#ifndef _7Semi_SCD4X_BUS_H
+#define _7Semi_SCD4X_BUS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+/**
+ * 7Semi_SCD4x_Bus.h
+ * -----------------
+ * Shared-bus arbiter: I²C transactions from several tasks and devices
+ * (SCD4x, display, RTC, barometer …) on one TwoWire, each command +
+ * response executed as one unit
+ *
+ * Model
+ * -----
+ * - A unit is: write tx, wait execUs, read rx. For one device address the
+ *   units run strictly one after another, so nothing can slip between a
+ *   command and its response.
+ * - While a unit waits out its execution time the bus is free; the
+ *   arbiter runs other devices' units in that gap (a 400 ms FRC or a 10 s
+ *   self-test does not hold the display or the RTC).
+ * - Order: higher priority first, then earlier deadline (0 = none), then
+ *   submission order. One transfer is the scheduling granularity.
+ * - submit() is lock-free (Treiber push, one CAS); only the arbiter task
+ *   touches Wire, the pending list and the timing.
+ *
+ * Usage (ESP32)
+ * -------------
+ * - arb.begin(&Wire); arb.startTask();
+ * - From any task: fill a SCD4x_BusUnit_7Semi and call transact(u) (blocks
+ *   the caller only) or submit(u) + done callback.
+ * - SCD4x_7Semi::setArbiter(&arb) routes the driver through it.
+ *
+ * Notes
+ * -----
+ * - Available on ESP32 (FreeRTOS + <atomic>) and host builds; other cores
+ *   have one thread and do not need it (SCD4X_BUS_ARBITER undefined).
+ * - Units are caller-owned and must stay alive until status leaves
+ *   SCD4X_BUS_PENDING (or the done callback returns); no heap.
+ * - tx / rx longer than the core's Wire buffer (128 bytes on ESP32) must
+ *   be split by the caller.
+ * - Call from tasks, not ISRs.
+ */
+
+#if defined(ARDUINO_ARCH_ESP32) || !defined(ARDUINO)
+#define SCD4X_BUS_ARBITER 1
+#endif
+
+#if defined(SCD4X_BUS_ARBITER)
+
+#include <atomic>
+
+#define SCD4X_BUS_PENDING  0
+#define SCD4X_BUS_OK       1
+#define SCD4X_BUS_NACK     2   // write not acknowledged
+#define SCD4X_BUS_SHORT    3   // read returned fewer bytes than requested
+#define SCD4X_BUS_TIMEOUT  4   // transact() gave up waiting
+
+struct SCD4x_BusUnit_7Semi;
+
+/** - Completion callback (runs on the arbiter task; keep it short) */
+typedef void (*SCD4x_BusDone_7Semi)(SCD4x_BusUnit_7Semi *unit, void *ctx);
+
+/**
+ * - One command + response transaction
+ * - Fill the request fields, leave the rest zero
+ */
+struct SCD4x_BusUnit_7Semi {
+  // ---- request ----
+  uint8_t        address;
+  uint8_t        priority;     // higher runs first
+  uint16_t       txLen;
+  uint16_t       rxLen;        // 0 = write only
+  const uint8_t *tx;
+  uint8_t       *rx;
+  uint32_t       execUs;       // wait between write and read
+  uint32_t       deadlineMs;   // absolute millis(), 0 = none
+  SCD4x_BusDone_7Semi done;
+  void          *ctx;
+
+  // ---- result ----
+  std::atomic<uint8_t> status;
+  bool           late;         // completed after deadlineMs
+  uint32_t       queuedUs;     // submit → first byte on the wire
+  uint32_t       totalUs;      // submit → completion
+
+  // ---- arbiter internals ----
+  SCD4x_BusUnit_7Semi *next;
+  uint32_t       seq;
+  uint32_t       submitUs;
+  uint32_t       readAtUs;
+  uint32_t       giveUpUs;     // transact(): drop if not started by then (0 = never)
+  void          *waiter;
+};
+
+/** - Running counters (arbiter task writes, anyone may read) */
+struct SCD4x_BusStats_7Semi {
+  uint32_t units;       // completed
+  uint32_t errors;      // NACK / SHORT
+  uint32_t late;        // completed after their deadline
+  uint32_t gapFills;    // units started while another device waited out its exec time
+  uint32_t maxPending;  // deepest pending list seen
+  uint32_t maxQueuedUs; // worst submit → start
+};
+
+class SCD4x_BusArbiter_7Semi {
+public:
+  SCD4x_BusArbiter_7Semi();
+
+  /** - Bind to the bus (Wire must already be begun) */
+  void begin(TwoWire *wire);
+
+  /**
+   * - Queue a unit (lock-free, any task)
+   * - return : false if the unit is malformed (no tx, or rx without buffer)
+   */
+  bool submit(SCD4x_BusUnit_7Semi &u);
+
+  /**
+   * - Submit and block the calling task until the unit completes
+   * - timeout_ms : give up (SCD4X_BUS_TIMEOUT) if not started by then; a
+   *                started unit always runs to completion, so u is never
+   *                referenced after return
+   * - Without startTask() the caller drives poll() itself (one thread only)
+   * - return : true on SCD4X_BUS_OK
+   */
+  bool transact(SCD4x_BusUnit_7Semi &u, uint32_t timeout_ms = 1000);
+
+  /**
+   * - One scheduling step: drain submissions, finish due reads, start the
+   *   best runnable unit
+   * - return : µs until poll() has work again (0 = call again now)
+   */
+  uint32_t poll();
+
+#if defined(ARDUINO_ARCH_ESP32)
+  /**
+   * - Run poll() on a dedicated FreeRTOS task that sleeps between deadlines
+   *   and wakes on submit()
+   * - priority : FreeRTOS priority (above the submitting tasks)
+   * - core     : tskNO_AFFINITY or 0 / 1
+   */
+  bool startTask(uint32_t stack_bytes = 3072, uint8_t priority = 5, int core = tskNO_AFFINITY);
+#endif
+
+  const SCD4x_BusStats_7Semi &stats() const { return st; }
+
+  // --------- SCD4x framing helpers ---------
+
+  /**
+   * - Fill tx with a 16-bit command + words (each followed by its CRC)
+   * - tx must hold 2 + 3 * nwords bytes; return : bytes written
+   */
+  static uint16_t frameCommand(uint8_t *tx, uint16_t cmd, const uint16_t *words, uint8_t nwords);
+  /**
+   * - Check CRC and unpack nwords words from rx
+   * - return : false on CRC mismatch
+   */
+  static bool unpackWords(const uint8_t *rx, uint16_t *out, uint8_t nwords);
+
+private:
+  TwoWire *i2c = nullptr;
+  std::atomic<SCD4x_BusUnit_7Semi *> inbox;  // Treiber stack of submissions
+  SCD4x_BusUnit_7Semi *pending = nullptr;    // arbiter-owned, unsorted
+  SCD4x_BusUnit_7Semi *waiting = nullptr;    // wrote, waiting exec time
+  uint32_t seq = 0;
+  SCD4x_BusStats_7Semi st;
+#if defined(ARDUINO_ARCH_ESP32)
+  void *task = nullptr;
+  static void taskMain(void *self);
+#endif
+
+  static uint8_t crc8(uint8_t b0, uint8_t b1);
+  void drain();
+  bool before(const SCD4x_BusUnit_7Semi *a, const SCD4x_BusUnit_7Semi *b) const;
+  bool addressBusy(uint8_t address) const;
+  void start(SCD4x_BusUnit_7Semi *u);
+  void finishRead(SCD4x_BusUnit_7Semi *u);
+  void complete(SCD4x_BusUnit_7Semi *u, uint8_t status);
+  void wake();
+};
+
+#endif  // SCD4X_BUS_ARBITER
+
+#endif  // _7Semi_SCD4X_BUS_H
@@ -0,0 +1,214 @@
+/**
+ * 7Semi_SCD4x_Delta.cpp
+ * ---------------------
+ * Delta / zigzag / varint block codec for raw sample logs
+ *
+ * Implementation Notes
+ * --------------------
+ * - Deltas are taken in int64 so uint32 timestamps and uint16 words never wrap
+ *   into the wrong sign; timestamps themselves wrap modulo 2³² as millis() does.
+ * - Varint = LEB128 (7 bits per byte, MSB = continuation), ≤ 10 bytes.
+ * - The trailer length follows the version byte: 1 (CRC-8) for version 1,
+ *   SCD4X_DELTA_CRC_LEN for the current version.
+ */
+
+#include "7Semi_SCD4x_Delta.h"
+
+static inline uint64_t zigzag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+
+static inline int64_t unzigzag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+
+static inline void putU16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void putU32(uint8_t *p, uint32_t v) {
+  putU16(p, (uint16_t)v);
+  putU16(p + 2, (uint16_t)(v >> 16));
+}
+
+static inline uint16_t getU16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+static inline uint32_t getU32(const uint8_t *p) { return getU16(p) | ((uint32_t)getU16(p + 2) << 16); }
+
+static inline size_t trailerLen(uint8_t version) { return version == 1 ? 1 : SCD4X_DELTA_CRC_LEN; }
+
+// ================= Encoder =================
+
+/**
+- Bind encoder to buffer
+*/
+SCD4x_DeltaEncoder_7Semi::SCD4x_DeltaEncoder_7Semi(uint8_t *b, size_t c)
+  : buf(b), cap(c > 65535 ? 65535 : c) {
+  restart();
+}
+
+/**
+- Append one sample
+- return : false when the block has no room (caller finishes and restarts)
+*/
+bool SCD4x_DeltaEncoder_7Semi::add(const SCD4x_RawSample_7Semi &s) {
+  if (n == 0) {
+    if (cap < SCD4X_DELTA_HEADER_LEN + SCD4X_DELTA_CRC_LEN) return false;
+    buf[0] = SCD4X_DELTA_SYNC;
+    buf[1] = SCD4X_DELTA_VERSION;
+    putU32(buf + 5, s.t_ms);
+    putU16(buf + 9, s.co2_raw);
+    putU16(buf + 11, s.t_raw);
+    putU16(buf + 13, s.rh_raw);
+    len = SCD4X_DELTA_HEADER_LEN;
+    prevDt = 0;
+  } else {
+    if (n == 255 || len + SCD4X_DELTA_MAX_RECORD + SCD4X_DELTA_CRC_LEN > cap) return false;
+    const uint32_t dt = s.t_ms - prev.t_ms;
+    putVarint(zigzag((int64_t)dt - (int64_t)prevDt));
+    putVarint(zigzag((int64_t)s.co2_raw - prev.co2_raw));
+    putVarint(zigzag((int64_t)s.t_raw - prev.t_raw));
+    putVarint(zigzag((int64_t)s.rh_raw - prev.rh_raw));
+    prevDt = dt;
+  }
+  prev = s;
+  ++n;
+  return true;
+}
+
+/**
+- Close block: write count, length and CRC
+*/
+size_t SCD4x_DeltaEncoder_7Semi::finish() {
+  if (n == 0) return 0;
+  const size_t total = len + SCD4X_DELTA_CRC_LEN;
+  buf[2] = n;
+  putU16(buf + 3, (uint16_t)total);
+  putU16(buf + len, SCD4x_DeltaDecoder_7Semi::crc16(buf, len));
+  return total;
+}
+
+void SCD4x_DeltaEncoder_7Semi::restart() {
+  len = 0;
+  n = 0;
+  prevDt = 0;
+}
+
+uint8_t SCD4x_DeltaEncoder_7Semi::count() const { return n; }
+
+size_t SCD4x_DeltaEncoder_7Semi::size() const { return len; }
+
+const uint8_t *SCD4x_DeltaEncoder_7Semi::data() const { return buf; }
+
+void SCD4x_DeltaEncoder_7Semi::putVarint(uint64_t v) {
+  while (v >= 0x80) {
+    buf[len++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  buf[len++] = (uint8_t)v;
+}
+
+// ================= Decoder =================
+
+/**
+- Validate block header, length and CRC
+*/
+bool SCD4x_DeltaDecoder_7Semi::open(const uint8_t *block, size_t avail) {
+  p = end = nullptr;
+  len = blockLength(block, avail);
+  if (len == 0) return false;
+  const size_t body = len - trailerLen(block[1]);
+  if (block[1] == 1 ? crc8(block, body) != block[body] : crc16(block, body) != getU16(block + body)) return false;
+
+  n = block[2];
+  index = 0;
+  p = block + SCD4X_DELTA_HEADER_LEN;
+  end = block + body;
+  prev.t_ms = getU32(block + 5);
+  prev.co2_raw = getU16(block + 9);
+  prev.t_raw = getU16(block + 11);
+  prev.rh_raw = getU16(block + 13);
+  prevDt = 0;
+  return true;
+}
+
+/**
+- Decode next sample
+*/
+bool SCD4x_DeltaDecoder_7Semi::next(SCD4x_RawSample_7Semi &s) {
+  if (!p || index >= n) return false;
+  if (index > 0) {
+    uint64_t dod, dc, dtw, dr;
+    if (!getVarint(dod) || !getVarint(dc) || !getVarint(dtw) || !getVarint(dr)) {
+      p = nullptr;
+      return false;
+    }
+    prevDt = (uint32_t)((int64_t)prevDt + unzigzag(dod));
+    prev.t_ms += prevDt;
+    prev.co2_raw = (uint16_t)(prev.co2_raw + unzigzag(dc));
+    prev.t_raw = (uint16_t)(prev.t_raw + unzigzag(dtw));
+    prev.rh_raw = (uint16_t)(prev.rh_raw + unzigzag(dr));
+  }
+  ++index;
+  s = prev;
+  return true;
+}
+
+uint8_t SCD4x_DeltaDecoder_7Semi::count() const { return n; }
+
+size_t SCD4x_DeltaDecoder_7Semi::length() const { return len; }
+
+/**
+- Declared block length, or 0 if the header is not plausible
+*/
+size_t SCD4x_DeltaDecoder_7Semi::blockLength(const uint8_t *b, size_t avail) {
+  if (avail < SCD4X_DELTA_HEADER_LEN + 1) return 0;
+  if (b[0] != SCD4X_DELTA_SYNC || (b[1] != SCD4X_DELTA_VERSION && b[1] != 1) || b[2] == 0) return 0;
+  const size_t l = getU16(b + 3);
+  if (l < SCD4X_DELTA_HEADER_LEN + trailerLen(b[1]) || l > avail) return 0;
+  return l;
+}
+
+/**
+- Decode whole block into out[]
+*/
+size_t SCD4x_DeltaDecoder_7Semi::decodeBlock(const uint8_t *block, size_t avail,
+                                             SCD4x_RawSample_7Semi *out, size_t max) {
+  SCD4x_DeltaDecoder_7Semi d;
+  if (!d.open(block, avail)) return 0;
+  size_t k = 0;
+  while (k < max && d.next(out[k])) ++k;
+  return k;
+}
+
+/**
+- CRC-16/CCITT-FALSE over a byte range (same CRC as the profile slots)
+*/
+uint16_t SCD4x_DeltaDecoder_7Semi::crc16(const uint8_t *b, size_t n) {
+  uint16_t crc = 0xFFFF;
+  while (n--) {
+    crc ^= (uint16_t)(*b++) << 8;
+    for (uint8_t i = 0; i < 8; ++i) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+/**
+- CRC-8 over a byte range (same polynomial as the sensor word CRC; version 1)
+*/
+uint8_t SCD4x_DeltaDecoder_7Semi::crc8(const uint8_t *b, size_t n) {
+  uint8_t crc = 0xFF;
+  for (size_t i = 0; i < n; ++i) {
+    crc ^= b[i];
+    for (int k = 0; k < 8; ++k) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+  }
+  return crc;
+}
+
+bool SCD4x_DeltaDecoder_7Semi::getVarint(uint64_t &v) {
+  v = 0;
+  for (uint8_t shift = 0; shift < 64; shift += 7) {
+    if (p >= end) return false;
+    const uint8_t b = *p++;
+    v |= (uint64_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
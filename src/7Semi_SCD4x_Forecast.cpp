@@ -0,0 +1,105 @@
+/**
+ * 7Semi_SCD4x_Forecast.cpp
+ * ------------------------
+ * Holt linear smoothing on the CO₂ stream
+ *
+ * Implementation Notes
+ * --------------------
+ * - Gains are applied as (x · g) / 256 with int64 products, so α·Δ never overflows.
+ * - Trend is normalised per minute: slope = ΔL · 60000 / Δt_ms.
+ * - A zero Δt (duplicate timestamp) is ignored.
+ * - Prediction and observed slope are formed in int64 and clamped to
+ *   SCD4X_FORECAST_MAX_Q8 before narrowing: a 1 ms Δt turns a full-scale
+ *   step into ~10¹² Q8 ppm/min, and a long gap times the trend can exceed
+ *   int32 as well. The filtered trend is a blend of clamped values, so it
+ *   stays in range too.
+ */
+
+#include "7Semi_SCD4x_Forecast.h"
+
+/**
+- Construct forecaster with gains (Q8)
+*/
+SCD4x_Forecast_7Semi::SCD4x_Forecast_7Semi(uint16_t alpha_q8, uint16_t beta_q8) {
+  setGains(alpha_q8, beta_q8);
+}
+
+void SCD4x_Forecast_7Semi::setGains(uint16_t a, uint16_t b) {
+  alpha = (a == 0) ? 1 : (a > 256 ? 256 : a);
+  beta  = (b == 0) ? 1 : (b > 256 ? 256 : b);
+}
+
+void SCD4x_Forecast_7Semi::reset() {
+  seeded = false;
+  levelQ8 = 0;
+  slopeQ8 = 0;
+}
+
+/**
+- Feed one sample
+- return : true once level and trend are valid
+*/
+bool SCD4x_Forecast_7Semi::update(uint16_t co2_ppm, uint32_t now_ms) {
+  const int32_t xQ8 = (int32_t)co2_ppm << 8;
+  if (!seeded) {
+    levelQ8 = xQ8;
+    slopeQ8 = 0;
+    lastMs = now_ms;
+    seeded = true;
+    return false;
+  }
+
+  const uint32_t dt = now_ms - lastMs;
+  if (dt == 0) return true;
+  lastMs = now_ms;
+
+  // Predict, then correct level
+  const int32_t prev = levelQ8;
+  const int32_t pred = clampQ8((int64_t)prev + (int64_t)slopeQ8 * (int64_t)dt / 60000);
+  levelQ8 = pred + (int32_t)((int64_t)(xQ8 - pred) * alpha / 256);
+
+  // Correct trend toward observed level slope
+  const int32_t obs = clampQ8((int64_t)(levelQ8 - prev) * 60000 / (int64_t)dt);
+  slopeQ8 += (int32_t)((int64_t)(obs - slopeQ8) * beta / 256);
+  return true;
+}
+
+uint16_t SCD4x_Forecast_7Semi::level() const {
+  if (levelQ8 <= 0) return 0;
+  return (uint16_t)((levelQ8 + 128) >> 8);
+}
+
+int32_t SCD4x_Forecast_7Semi::trendQ8() const { return slopeQ8; }
+
+/**
+- Forecast ahead_s seconds past the last sample (ppm, clamped)
+*/
+uint16_t SCD4x_Forecast_7Semi::forecast(uint32_t ahead_s) const {
+  int64_t f = (int64_t)levelQ8 + (int64_t)slopeQ8 * (int64_t)ahead_s / 60;
+  if (f <= 0) return 0;
+  f = (f + 128) >> 8;
+  return (f > 65535) ? 65535 : (uint16_t)f;
+}
+
+/**
+- Time to reach threshold_ppm at the current trend
+- return : seconds (0 = already reached, UINT32_MAX = not approaching)
+*/
+uint32_t SCD4x_Forecast_7Semi::secondsUntil(uint16_t threshold_ppm) const {
+  const int32_t thrQ8 = (int32_t)threshold_ppm << 8;
+  if (levelQ8 >= thrQ8) return 0;
+  if (slopeQ8 <= 0) return UINT32_MAX;
+  int64_t s = (int64_t)(thrQ8 - levelQ8) * 60 / slopeQ8;
+  return (s > (int64_t)UINT32_MAX - 1) ? UINT32_MAX - 1 : (uint32_t)s;
+}
+
+// ================= Helpers =================
+
+/**
+- Narrow an int64 Q8 value to ±SCD4X_FORECAST_MAX_Q8
+*/
+int32_t SCD4x_Forecast_7Semi::clampQ8(int64_t v) {
+  if (v > SCD4X_FORECAST_MAX_Q8) return SCD4X_FORECAST_MAX_Q8;
+  if (v < -SCD4X_FORECAST_MAX_Q8) return -SCD4X_FORECAST_MAX_Q8;
+  return (int32_t)v;
+}
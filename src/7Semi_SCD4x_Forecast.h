@@ -0,0 +1,80 @@
+#ifndef _7Semi_SCD4X_FORECAST_H
+#define _7Semi_SCD4X_FORECAST_H
+
+#include <Arduino.h>
+
+#define SCD4X_FORECAST_MAX_Q8  ((int32_t)65535 << 8)  // level / trend clamp (Q8)
+
+/**
+ * 7Semi_SCD4x_Forecast.h
+ * ----------------------
+ * Short-term CO₂ forecast (Holt linear / double exponential smoothing)
+ *
+ * Model
+ * -----
+ *   L⁻ = L + b·Δt
+ *   L  = L⁻ + α·(x − L⁻)
+ *   b  = b + β·((L − L_prev)/Δt − b)
+ *   x̂(t + h) = L + b·h
+ *
+ * Notes
+ * -----
+ * - Integer only: level in Q8 ppm, trend in Q8 ppm/min; 17 bytes of state
+ *   (20 with padding).
+ * - The observed trend is clamped to ±65535 ppm/min, so closely spaced
+ *   timestamps (Δt of a few ms) cannot overflow it.
+ * - Δt comes from the caller's timestamps, so periodic (5 s), low-power (30 s)
+ *   and single-shot cadences all work without retuning.
+ * - α, β are Q8 (256 = 1.0). Defaults α = 0.25, β = 0.0625 suit 5 s sampling.
+ */
+
+class SCD4x_Forecast_7Semi {
+public:
+  /**
+   * - Construct forecaster
+   * - alpha_q8 : level gain (1..256)
+   * - beta_q8  : trend gain (1..256)
+   */
+  SCD4x_Forecast_7Semi(uint16_t alpha_q8 = 64, uint16_t beta_q8 = 16);
+
+  /** - Set smoothing gains (Q8, clamped to 1..256) */
+  void setGains(uint16_t alpha_q8, uint16_t beta_q8);
+  /** - Forget state; next sample re-seeds level and zeroes trend */
+  void reset();
+
+  /**
+   * - Feed one CO₂ sample
+   * - co2_ppm : CO₂ from readMeasurement()
+   * - now_ms  : millis() at read time
+   * - return  : true once a trend is available (second sample on)
+   */
+  bool update(uint16_t co2_ppm, uint32_t now_ms);
+
+  /** - Smoothed CO₂ level in ppm */
+  uint16_t level() const;
+  /** - Trend in ppm/min, Q8 (256 = 1 ppm/min) */
+  int32_t trendQ8() const;
+  /**
+   * - Predicted CO₂ ahead_s seconds after the last sample
+   * - return : ppm, clamped to 0..65535
+   */
+  uint16_t forecast(uint32_t ahead_s) const;
+  /**
+   * - Seconds until the forecast reaches threshold_ppm
+   * - return : 0 if already at/above, UINT32_MAX if trend is flat or falling
+   */
+  uint32_t secondsUntil(uint16_t threshold_ppm) const;
+
+private:
+  uint16_t alpha;
+  uint16_t beta;
+  bool     seeded = false;
+  uint32_t lastMs = 0;
+  int32_t  levelQ8 = 0;  // ppm × 256
+  int32_t  slopeQ8 = 0;  // ppm/min × 256
+
+  /** - Narrow to ±SCD4X_FORECAST_MAX_Q8 */
+  static int32_t clampQ8(int64_t v);
+};
+
+#endif  // _7Semi_SCD4X_FORECAST_H
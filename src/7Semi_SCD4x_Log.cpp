@@ -0,0 +1,460 @@
+/**
+ * 7Semi_SCD4x_Log.cpp
+ * -------------------
+ * Double-buffered, CRC-protected append-only sample log
+ *
+ * Implementation Notes
+ * --------------------
+ * - Only the inactive page can be pending, so the hand-off needs one bit per
+ *   page: the producer sets it after the page is complete, service() clears
+ *   it after the write. The producer never touches a page whose bit is set.
+ * - With SCD4X_LOG_ATOMIC the set is a release and the load an acquire, so
+ *   page bytes and pageOffset written before sealing are visible to the
+ *   other core; the clear is a release so the page write completes before
+ *   the producer refills it.
+ * - Sequence number and file offset are assigned when a page is sealed, so
+ *   service() only copies bytes and never changes ordering.
+ * - CRC-32 uses a 16-entry nibble table (64 bytes) — small enough for AVR.
+ * - The zone map is folded in per sample in append(), so sealing only copies
+ *   24 bytes; begin() restores epoch / last t_ms from the last zone map.
+ * - On reopen the header block decides the layout. The tail scan only runs
+ *   at the stored block size, and a file without a valid header is refused
+ *   rather than overwritten.
+ */
+
+#include "7Semi_SCD4x_Log.h"
+
+#include <string.h>
+
+static inline void putU16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void putU32(uint8_t *p, uint32_t v) {
+  putU16(p, (uint16_t)v);
+  putU16(p + 2, (uint16_t)(v >> 16));
+}
+
+static inline uint16_t getU16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+static inline uint32_t getU32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+- Construct writer over two pages
+*/
+SCD4x_Log_7Semi::SCD4x_Log_7Semi(uint8_t *pageA, uint8_t *pageB, uint16_t bs, uint8_t enc)
+  : blockSize(bs < SCD4X_LOG_MIN_BLOCK ? SCD4X_LOG_MIN_BLOCK : bs),
+    encoding(enc == SCD4X_LOG_ENC_RAW ? SCD4X_LOG_ENC_RAW : SCD4X_LOG_ENC_DELTA),
+    pageSize(blockSize), pageEncoding(encoding),
+    delta(pageA + SCD4X_LOG_HEADER_LEN, 0) {
+  page[0] = pageA;
+  page[1] = pageB;
+}
+
+/**
+- Attach storage and recover the last valid block
+- serial : 48-bit sensor serial
+*/
+bool SCD4x_Log_7Semi::begin(SCD4x_LogStorage_7Semi &st, uint64_t sn) {
+  SCD4x_LogInfo_7Semi info;
+  info.serial = sn;
+  return begin(st, info);
+}
+
+/**
+- Attach storage: new file → write the header block; existing file →
+  validate its header and serial, adopt its block size / encoding,
+  recover the tail
+- info : identity / config snapshot (written only for a new file)
+*/
+bool SCD4x_Log_7Semi::begin(SCD4x_LogStorage_7Semi &st, const SCD4x_LogInfo_7Semi &info) {
+  storage = &st;
+  serial = info.serial & 0xFFFFFFFFFFFFULL;
+  resetSealed();
+  active = 0;
+  seq = 0;
+  offset = 0;
+  nBlocks = nDropped = nPadding = nErrors = 0;
+  sinceSync = 0;
+  epoch = 0;
+  lastMs = 0;
+  haveLast = false;
+  beginErr = BEGIN_OK;
+
+  // Existing file: block 0 must be a valid header; adopt its layout
+  blockSize = pageSize;
+  encoding = pageEncoding;
+  const uint32_t size = storage->size();
+  if (size > 0) {
+    if (size < SCD4X_LOG_MIN_BLOCK) return failBegin(BEGIN_BAD_HEADER);
+    if (!storage->read(0, page[0], SCD4X_LOG_MIN_BLOCK)) return failBegin(BEGIN_IO_ERROR);
+    const uint16_t bs = getU16(page[0] + 18);
+    if (page[0][5] != SCD4X_LOG_TYPE_HEADER || bs < SCD4X_LOG_MIN_BLOCK || bs > pageSize || bs > size)
+      return failBegin(BEGIN_BAD_HEADER);
+    if (!storage->read(0, page[0], bs)) return failBegin(BEGIN_IO_ERROR);
+    SCD4x_LogInfo_7Semi stored;
+    if (!parseHeader(page[0], bs, stored)) return failBegin(BEGIN_BAD_HEADER);
+    if (stored.encoding != SCD4X_LOG_ENC_RAW && stored.encoding != SCD4X_LOG_ENC_DELTA)
+      return failBegin(BEGIN_BAD_HEADER);
+    if (stored.serial != serial) return failBegin(BEGIN_SERIAL_MISMATCH);
+    blockSize = bs;
+    encoding = stored.encoding;
+  }
+
+  // Scan back for the last intact block; page[0] is scratch here
+  uint32_t n = size / blockSize;
+  while (n > 0) {
+    --n;
+    if (!storage->read(n * blockSize, page[0], blockSize)) return failBegin(BEGIN_IO_ERROR);
+    if (!validBlock(page[0], blockSize)) continue;
+    if (page[0][5] == SCD4X_LOG_TYPE_SAMPLES) {
+      seq = getU32(page[0] + 8) + 1;
+      SCD4x_LogZone_7Semi z;
+      if (readZone(page[0], blockSize, z)) {
+        epoch = z.epochLast;
+        lastMs = z.tLast;
+        haveLast = true;
+      }
+    }
+    offset = (n + 1) * blockSize;
+    break;
+  }
+
+  if (offset == 0) {
+    if (size > 0) return failBegin(BEGIN_BAD_HEADER);  // never write a header over existing data
+    if (!writeHeader(info)) return failBegin(BEGIN_IO_ERROR);
+    offset = blockSize;
+  }
+
+  openPage();
+  return true;
+}
+
+void SCD4x_Log_7Semi::setMaxAge(uint32_t ms) { maxAge = ms; }
+
+void SCD4x_Log_7Semi::setSyncEvery(uint8_t n) { syncEvery = n; }
+
+/**
+- Append one sample
+- return : false if dropped (writer behind by a full page)
+*/
+bool SCD4x_Log_7Semi::append(const SCD4x_RawSample_7Semi &s) {
+  if (!storage) return false;
+
+  bool fits;
+  if (encoding == SCD4X_LOG_ENC_RAW) fits = (used + SCD4X_LOG_RAW_RECORD <= payloadCap());
+  else fits = delta.add(s);
+
+  if (!fits) {
+    if (!sealActive()) {
+      ++nDropped;
+      return false;
+    }
+    if (encoding == SCD4X_LOG_ENC_DELTA) delta.add(s);
+  }
+
+  if (count == 0) openedMs = s.t_ms;
+  updateZone(s);
+  if (encoding == SCD4X_LOG_ENC_RAW) {
+    uint8_t *p = page[active] + SCD4X_LOG_HEADER_LEN + used;
+    putU32(p, s.t_ms);
+    putU16(p + 4, s.co2_raw);
+    putU16(p + 6, s.t_raw);
+    putU16(p + 8, s.rh_raw);
+    used += SCD4X_LOG_RAW_RECORD;
+  }
+  ++count;
+  return true;
+}
+
+/**
+- Seal the active page if it is older than maxAge
+- now_ms : same clock as the samples' t_ms
+*/
+void SCD4x_Log_7Semi::poll(uint32_t now_ms) {
+  if (maxAge && count && (now_ms - openedMs) >= maxAge) sealActive();
+}
+
+/**
+- Write the pending page, if any
+*/
+bool SCD4x_Log_7Semi::service() {
+  const uint8_t pending = loadSealed();
+  if (!storage || !pending) return false;
+  if (!(pending & 3)) {  // sync request with nothing left to write
+    sinceSync = 0;
+    if (!storage->sync()) ++nErrors;
+    clearSealed(SYNC_REQ);
+    return false;
+  }
+  const uint8_t i = (pending & 1) ? 0 : 1;  // at most one page is pending
+
+  if (!storage->write(pageOffset[i], page[i], blockSize)) {
+    ++nErrors;
+    return false;  // stays pending; retried on next service()
+  }
+  ++nBlocks;
+  if ((pending & SYNC_REQ) || (syncEvery && ++sinceSync >= syncEvery)) {
+    sinceSync = 0;
+    if (!storage->sync()) ++nErrors;
+  }
+  clearSealed((uint8_t)((1 << i) | (pending & SYNC_REQ)));
+  return true;
+}
+
+/**
+- Seal, write and sync everything (producer and service on this task)
+*/
+bool SCD4x_Log_7Semi::flush() {
+  if (!storage) return false;
+  service();
+  if (count && !sealActive()) return false;
+  if ((loadSealed() & 3) && !service()) return false;
+  clearSealed(SYNC_REQ);
+  sinceSync = 0;
+  return storage->sync();
+}
+
+/**
+- Seal the active page and leave write + sync to the service task
+*/
+bool SCD4x_Log_7Semi::requestFlush() {
+  if (!storage) return false;
+  if (count && !sealActive()) return false;
+  markSealed(SYNC_REQ);
+  return true;
+}
+
+// ================= Stats =================
+
+uint32_t SCD4x_Log_7Semi::nextSequence() const { return seq; }
+
+uint32_t SCD4x_Log_7Semi::blocksWritten() const { return nBlocks; }
+
+uint32_t SCD4x_Log_7Semi::samplesDropped() const { return nDropped; }
+
+uint32_t SCD4x_Log_7Semi::paddingBytes() const { return nPadding; }
+
+uint32_t SCD4x_Log_7Semi::writeErrors() const { return nErrors; }
+
+// ================= Block helpers =================
+
+/**
+- Magic + CRC check
+*/
+bool SCD4x_Log_7Semi::validBlock(const uint8_t *b, uint16_t bs) {
+  if (bs < SCD4X_LOG_MIN_BLOCK) return false;
+  if (b[0] != SCD4X_LOG_MAGIC0 || b[1] != SCD4X_LOG_MAGIC1 ||
+      b[2] != SCD4X_LOG_MAGIC2 || b[3] != SCD4X_LOG_MAGIC3) return false;
+  return crc32(b, bs - 4) == getU32(b + bs - 4);
+}
+
+/**
+- CRC-32 (IEEE), nibble-table implementation
+*/
+uint32_t SCD4x_Log_7Semi::crc32(const uint8_t *p, size_t n) {
+  static const uint32_t T[16] = {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL,
+  };
+  uint32_t crc = 0xFFFFFFFFUL;
+  while (n--) {
+    crc ^= *p++;
+    crc = (crc >> 4) ^ T[crc & 0x0F];
+    crc = (crc >> 4) ^ T[crc & 0x0F];
+  }
+  return ~crc;
+}
+
+/**
+- Parse the file header block
+*/
+bool SCD4x_Log_7Semi::parseHeader(const uint8_t *b, size_t avail, SCD4x_LogInfo_7Semi &info) {
+  if (avail < SCD4X_LOG_MIN_BLOCK || b[5] != SCD4X_LOG_TYPE_HEADER) return false;
+  const uint16_t bs = getU16(b + 18);
+  if (bs < SCD4X_LOG_MIN_BLOCK || bs > avail || !validBlock(b, bs)) return false;
+
+  info.serial = getU32(b + 12) | ((uint64_t)getU16(b + 16) << 32);
+  info.blockSize = bs;
+  info.encoding = b[6];
+  info.variant = getU16(b + 24);
+  info.tempOffsetRaw = getU16(b + 26);
+  info.altitudeM = getU16(b + 28);
+  info.pressureRaw = getU16(b + 30);
+  info.ascTargetPpm = getU16(b + 32);
+  info.ascInitialHours = getU16(b + 34);
+  info.ascStandardHours = getU16(b + 36);
+  info.ascEnabled = b[38];
+  info.mode = b[39];
+  info.periodMs = getU32(b + 40);
+  info.createdUnix = getU32(b + 44);
+  return true;
+}
+
+/**
+- Zone map of a sample block
+*/
+bool SCD4x_Log_7Semi::readZone(const uint8_t *b, uint16_t bs, SCD4x_LogZone_7Semi &z) {
+  if (b[5] != SCD4X_LOG_TYPE_SAMPLES || !(b[7] & SCD4X_LOG_FLAG_ZONE)) return false;
+  const uint8_t *p = b + bs - 4 - SCD4X_LOG_ZONE_LEN;
+  z.tFirst = getU32(p);
+  z.tLast = getU32(p + 4);
+  z.epochFirst = getU16(p + 8);
+  z.epochLast = getU16(p + 10);
+  z.co2Min = getU16(p + 12);
+  z.co2Max = getU16(p + 14);
+  z.tMin = getU16(p + 16);
+  z.tMax = getU16(p + 18);
+  z.rhMin = getU16(p + 20);
+  z.rhMax = getU16(p + 22);
+  return true;
+}
+
+#if defined(ARDUINO)
+/**
+- Snapshot sensor identity and configuration (sensor idle)
+*/
+bool SCD4x_Log_7Semi::captureInfo(SCD4x_7Semi &sensor, SCD4x_LogInfo_7Semi &info) {
+  bool ok = sensor.readSerialNumber(info.serial);
+  ok &= sensor.getSensorVariantRaw(info.variant);
+  float off = 0.0f;
+  if (sensor.getTemperatureOffset(off)) info.tempOffsetRaw = (uint16_t)(off * 65535.0f / 175.0f + 0.5f);
+  else ok = false;
+  ok &= sensor.getSensorAltitude(info.altitudeM);
+  ok &= sensor.getAmbientPressureRaw(info.pressureRaw);
+  bool asc = false;
+  if (sensor.getAutomaticSelfCalibrationEnabled(asc)) info.ascEnabled = asc ? 1 : 0;
+  else ok = false;
+  ok &= sensor.getAutomaticSelfCalibrationTarget(info.ascTargetPpm);
+  ok &= sensor.getAutomaticSelfCalibrationInitialPeriod(info.ascInitialHours);
+  ok &= sensor.getAutomaticSelfCalibrationStandardPeriod(info.ascStandardHours);
+  return ok;
+}
+#endif
+
+// ================= Helpers =================
+
+/**
+- Write header block 0 synchronously
+*/
+bool SCD4x_Log_7Semi::writeHeader(const SCD4x_LogInfo_7Semi &info) {
+  uint8_t *b = page[0];
+  memset(b, 0, blockSize);
+  putHeader(b, SCD4X_LOG_TYPE_HEADER);
+  putU32(b + 8, 0);
+  putU16(b + 18, blockSize);
+  putU16(b + 20, 0);
+  putU16(b + 24, info.variant);
+  putU16(b + 26, info.tempOffsetRaw);
+  putU16(b + 28, info.altitudeM);
+  putU16(b + 30, info.pressureRaw);
+  putU16(b + 32, info.ascTargetPpm);
+  putU16(b + 34, info.ascInitialHours);
+  putU16(b + 36, info.ascStandardHours);
+  b[38] = info.ascEnabled;
+  b[39] = info.mode;
+  putU32(b + 40, info.periodMs);
+  putU32(b + 44, info.createdUnix);
+  putU32(b + blockSize - 4, crc32(b, blockSize - 4));
+  if (!storage->write(0, b, blockSize) || !storage->sync()) {
+    ++nErrors;
+    return false;
+  }
+  return true;
+}
+
+void SCD4x_Log_7Semi::putHeader(uint8_t *b, uint8_t type) const {
+  b[0] = SCD4X_LOG_MAGIC0;
+  b[1] = SCD4X_LOG_MAGIC1;
+  b[2] = SCD4X_LOG_MAGIC2;
+  b[3] = SCD4X_LOG_MAGIC3;
+  b[4] = SCD4X_LOG_VERSION;
+  b[5] = type;
+  b[6] = encoding;
+  b[7] = 0;
+  putU32(b + 12, (uint32_t)serial);
+  putU16(b + 16, (uint16_t)(serial >> 32));
+  putU16(b + 22, 0);
+}
+
+void SCD4x_Log_7Semi::updateZone(const SCD4x_RawSample_7Semi &s) {
+  // millis() wrapped or restarted: keep epoch:t_ms monotonic
+  if (haveLast && s.t_ms < lastMs) ++epoch;
+  lastMs = s.t_ms;
+  haveLast = true;
+
+  if (count == 0) {
+    zone.tFirst = s.t_ms;
+    zone.epochFirst = epoch;
+    zone.co2Min = zone.co2Max = s.co2_raw;
+    zone.tMin = zone.tMax = s.t_raw;
+    zone.rhMin = zone.rhMax = s.rh_raw;
+  } else {
+    if (s.co2_raw < zone.co2Min) zone.co2Min = s.co2_raw;
+    if (s.co2_raw > zone.co2Max) zone.co2Max = s.co2_raw;
+    if (s.t_raw < zone.tMin) zone.tMin = s.t_raw;
+    if (s.t_raw > zone.tMax) zone.tMax = s.t_raw;
+    if (s.rh_raw < zone.rhMin) zone.rhMin = s.rh_raw;
+    if (s.rh_raw > zone.rhMax) zone.rhMax = s.rh_raw;
+  }
+  zone.tLast = s.t_ms;
+  zone.epochLast = epoch;
+}
+
+void SCD4x_Log_7Semi::openPage() {
+  count = 0;
+  used = 0;
+  if (encoding == SCD4X_LOG_ENC_DELTA)
+    delta = SCD4x_DeltaEncoder_7Semi(page[active] + SCD4X_LOG_HEADER_LEN, payloadCap());
+}
+
+/**
+- Complete the active page and switch to the other one
+- return : false if the other page is still pending (nothing changed)
+*/
+bool SCD4x_Log_7Semi::sealActive() {
+  const uint8_t other = active ^ 1;
+  if (loadSealed() & (1 << other)) return false;
+  if (count == 0) return true;
+
+  uint8_t *b = page[active];
+  if (encoding == SCD4X_LOG_ENC_DELTA) used = (uint16_t)delta.finish();
+
+  putHeader(b, SCD4X_LOG_TYPE_SAMPLES);
+  putU32(b + 8, seq);
+  putU16(b + 18, count);
+  putU16(b + 20, used);
+  b[7] = SCD4X_LOG_FLAG_ZONE;
+  memset(b + SCD4X_LOG_HEADER_LEN + used, 0, payloadCap() - used);
+
+  uint8_t *z = b + blockSize - 4 - SCD4X_LOG_ZONE_LEN;
+  putU32(z, zone.tFirst);
+  putU32(z + 4, zone.tLast);
+  putU16(z + 8, zone.epochFirst);
+  putU16(z + 10, zone.epochLast);
+  putU16(z + 12, zone.co2Min);
+  putU16(z + 14, zone.co2Max);
+  putU16(z + 16, zone.tMin);
+  putU16(z + 18, zone.tMax);
+  putU16(z + 20, zone.rhMin);
+  putU16(z + 22, zone.rhMax);
+  putU32(b + blockSize - 4, crc32(b, blockSize - 4));
+
+  nPadding += payloadCap() - used;
+  pageOffset[active] = offset;
+  ++seq;
+  offset += blockSize;
+  markSealed((uint8_t)(1 << active));
+  active = other;
+  openPage();
+  return true;
+}
+
+uint16_t SCD4x_Log_7Semi::payloadCap() const {
+  return (uint16_t)(blockSize - SCD4X_LOG_HEADER_LEN - SCD4X_LOG_ZONE_LEN - 4);
+}
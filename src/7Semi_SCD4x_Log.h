@@ -0,0 +1,344 @@
+#ifndef _7Semi_SCD4X_LOG_H
+#define _7Semi_SCD4X_LOG_H
+
+#include "7Semi_SCD4x_Sample.h"
+#include "7Semi_SCD4x_Delta.h"
+#if defined(ARDUINO)
+#include "7Semi_SCD4x.h"
+#endif
+
+// Multi-core / multi-thread targets get an atomic hand-off with
+// acquire / release ordering; single-core boards keep a volatile byte
+#if !defined(SCD4X_LOG_ATOMIC)
+#if !defined(ARDUINO) || defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_ESP32) || defined(INC_FREERTOS_H)
+#define SCD4X_LOG_ATOMIC 1
+#else
+#define SCD4X_LOG_ATOMIC 0
+#endif
+#endif
+#if SCD4X_LOG_ATOMIC
+#include <atomic>
+#endif
+
+/**
+ * 7Semi_SCD4x_Log.h
+ * -----------------
+ * Append-only binary sample log (SD / LittleFS / host files)
+ *
+ * Block format (fixed blockSize bytes, little-endian)
+ * ---------------------------------------------------
+ *   [0..3]    magic "S4LB"
+ *   [4]       format version (1)
+ *   [5]       block type (0 = file header, 1 = samples)
+ *   [6]       encoding (0 = raw 10-byte records, 1 = delta codec block)
+ *   [7]       flags (bit 0 = zone map present)
+ *   [8..11]   block sequence number (monotonic per file)
+ *   [12..17]  sensor serial (48-bit, from readSerialNumber())
+ *   [18..19]  samples: sample count      header: block size
+ *   [20..21]  samples: payload length    header: 0
+ *   [22..23]  reserved (0)
+ *   [24..]    samples: payload, zero padded
+ *             header : SCD4x_LogInfo_7Semi snapshot (see extras/LOG_FORMAT.md)
+ *   [-28..]   samples: zone map (SCD4x_LogZone_7Semi, 24 bytes)
+ *   [-4..]    CRC-32 (IEEE 802.3) over bytes [0, blockSize − 4)
+ *
+ *   raw record: t_ms u32, co2_raw u16, t_raw u16, rh_raw u16
+ *
+ * - Block 0 of a file is the header block, written by begin() when the
+ *   file is empty; it makes the file self-describing for host readers.
+ * - Reopening a file adopts the block size and encoding from its header
+ *   (the block size must fit the pages); a non-empty file without a valid
+ *   header is rejected, never overwritten.
+ * - The zone map holds first/last t_ms and min/max of each raw channel, so
+ *   readers skip blocks that cannot match a time or threshold query. Its
+ *   epoch counts t_ms wraps (and millis() restarts), so epoch:t_ms never
+ *   decreases along the file and fixed-size blocks can be binary searched
+ *   by time — the block array is the sparse time index.
+ *
+ * Write path
+ * ----------
+ * - Two caller-provided pages: append() fills the active page while the
+ *   other one waits for service() to write it (SPSC hand-off, so service()
+ *   may run in another task on 32-bit cores).
+ * - Producer side: append(), poll(), requestFlush(). Service side:
+ *   service(). flush() does both and is only for sketches where append()
+ *   and service() run on the same task; with a writer task use
+ *   requestFlush() and let service() write and sync.
+ * - A page is sealed when full, when it is older than maxAge (poll()), or
+ *   on flush(). Short maxAge → smaller loss window but more padding
+ *   (write amplification); syncEvery sets how often storage is synced.
+ *
+ * Recovery
+ * --------
+ * - begin() scans back from the end of file for the last block with a valid
+ *   magic + CRC and resumes after it; a torn tail is overwritten.
+ * - A file is only reopened by the sensor that created it: the serial in
+ *   the header block must match the one passed to begin(), so a card moved
+ *   to another sensor is refused (beginStatus() = BEGIN_SERIAL_MISMATCH)
+ *   instead of mixing two sensors' data under one header.
+ */
+
+#define SCD4X_LOG_MAGIC0         'S'
+#define SCD4X_LOG_MAGIC1         '4'
+#define SCD4X_LOG_MAGIC2         'L'
+#define SCD4X_LOG_MAGIC3         'B'
+#define SCD4X_LOG_VERSION        1
+#define SCD4X_LOG_TYPE_HEADER    0
+#define SCD4X_LOG_TYPE_SAMPLES   1
+#define SCD4X_LOG_ENC_RAW        0
+#define SCD4X_LOG_ENC_DELTA      1
+#define SCD4X_LOG_HEADER_LEN     24
+#define SCD4X_LOG_RAW_RECORD     10
+#define SCD4X_LOG_ZONE_LEN       24
+#define SCD4X_LOG_FLAG_ZONE      0x01
+#define SCD4X_LOG_MIN_BLOCK      96
+
+/**
+ * - Sensor identity and configuration recorded in the file header block
+ * - blockSize / encoding are filled in by the writer
+ */
+struct SCD4x_LogInfo_7Semi {
+  uint64_t serial = 0;
+  uint16_t variant = 0;           // getSensorVariantRaw()
+  uint16_t tempOffsetRaw = 0;     // offset word: °C = 175 · raw / 65535
+  uint16_t altitudeM = 0;
+  uint16_t pressureRaw = 0;       // 0 = not set
+  uint16_t ascTargetPpm = 0;
+  uint16_t ascInitialHours = 0;
+  uint16_t ascStandardHours = 0;
+  uint8_t  ascEnabled = 0;
+  uint8_t  mode = 0;              // 0 unknown, 1 periodic, 2 low-power, 3 single-shot
+  uint32_t periodMs = 0;          // nominal sample period
+  uint32_t createdUnix = 0;       // 0 = unknown
+  uint16_t blockSize = 0;
+  uint8_t  encoding = 0;
+};
+
+/**
+ * - Per-block summary written in front of the CRC of every sample block
+ * - Time key of a sample = (epoch << 32) | t_ms
+ */
+struct SCD4x_LogZone_7Semi {
+  uint32_t tFirst = 0;
+  uint32_t tLast = 0;
+  uint16_t epochFirst = 0;
+  uint16_t epochLast = 0;
+  uint16_t co2Min = 0, co2Max = 0;   // raw words (co2_raw = ppm)
+  uint16_t tMin = 0, tMax = 0;
+  uint16_t rhMin = 0, rhMax = 0;
+
+  uint64_t firstKey() const { return ((uint64_t)epochFirst << 32) | tFirst; }
+  uint64_t lastKey() const { return ((uint64_t)epochLast << 32) | tLast; }
+};
+
+/**
+ * - Minimal positional storage used by the log
+ * - Implement for your file system, or use SCD4x_FileStorage_7Semi<File>
+ */
+class SCD4x_LogStorage_7Semi {
+public:
+  virtual ~SCD4x_LogStorage_7Semi() {}
+  /** - Current file size in bytes */
+  virtual uint32_t size() = 0;
+  /** - Read n bytes at offset; true if all read */
+  virtual bool read(uint32_t offset, uint8_t *buf, size_t n) = 0;
+  /** - Write n bytes at offset (may extend the file); true if all written */
+  virtual bool write(uint32_t offset, const uint8_t *buf, size_t n) = 0;
+  /** - Push data to the medium */
+  virtual bool sync() = 0;
+};
+
+/**
+ * - Adapter for Arduino File-like objects (SD, SdFat, LittleFS, SPIFFS)
+ * - File must be opened for read + write (e.g. "r+" / O_RDWR | O_CREAT)
+ */
+template <class FileT>
+class SCD4x_FileStorage_7Semi : public SCD4x_LogStorage_7Semi {
+public:
+  explicit SCD4x_FileStorage_7Semi(FileT &f) : file(f) {}
+  uint32_t size() override { return (uint32_t)file.size(); }
+  bool read(uint32_t offset, uint8_t *buf, size_t n) override {
+    return file.seek(offset) && (size_t)file.read(buf, n) == n;
+  }
+  bool write(uint32_t offset, const uint8_t *buf, size_t n) override {
+    return file.seek(offset) && (size_t)file.write(buf, n) == n;
+  }
+  bool sync() override {
+    file.flush();
+    return true;
+  }
+
+private:
+  FileT &file;
+};
+
+class SCD4x_Log_7Semi {
+public:
+  /**
+   * - Construct log writer over two caller-owned pages
+   * - pageA, pageB : blockSize bytes each
+   * - blockSize    : bytes per block (≥ 96, ≤ 65535; match flash page / SD sector)
+   * - encoding     : SCD4X_LOG_ENC_RAW or SCD4X_LOG_ENC_DELTA
+   */
+  SCD4x_Log_7Semi(uint8_t *pageA, uint8_t *pageB, uint16_t blockSize,
+                  uint8_t encoding = SCD4X_LOG_ENC_DELTA);
+
+  enum BeginStatus : uint8_t {
+    BEGIN_OK = 0,
+    BEGIN_IO_ERROR,          // storage read / header write failed
+    BEGIN_BAD_HEADER,        // no valid header block, or block size > pages
+    BEGIN_SERIAL_MISMATCH,   // file was written by another sensor
+  };
+
+  /**
+   * - Attach storage, recover the tail and start appending
+   * - serial : 48-bit sensor serial (readSerialNumber()) tagged on every
+   *            block; must match the header of an existing file
+   * - return : false on failure, reason in beginStatus()
+   */
+  bool begin(SCD4x_LogStorage_7Semi &storage, uint64_t serial);
+  /**
+   * - Same, recording a full sensor/config snapshot in the header block
+   * - info : written only when the file is empty (new log); info.serial
+   *          is checked against an existing header
+   */
+  bool begin(SCD4x_LogStorage_7Semi &storage, const SCD4x_LogInfo_7Semi &info);
+  /** - Outcome of the last begin() (BeginStatus) */
+  uint8_t beginStatus() const { return beginErr; }
+
+  /** - Seal pages older than max_age_ms (0 = only when full) */
+  void setMaxAge(uint32_t max_age_ms);
+  /** - Sync storage every n written blocks (0 = never, flush() always syncs) */
+  void setSyncEvery(uint8_t n);
+
+  /**
+   * - Append one sample to the active page
+   * - return : false if both pages are waiting for service() (sample dropped)
+   */
+  bool append(const SCD4x_RawSample_7Semi &s);
+  /** - Apply the max-age policy; call periodically with millis() */
+  void poll(uint32_t now_ms);
+  /**
+   * - Write a sealed page, if any (call from loop() or a writer task)
+   * - return : true if a block was written
+   */
+  bool service();
+  /**
+   * - Seal the active page, write everything pending and sync
+   * - Single-task use only: append() and service() on the calling task
+   */
+  bool flush();
+  /**
+   * - Producer side: seal the active page and ask service() to sync after
+   *   writing it (writer-task setups)
+   * - return : false if the other page is still pending (retry later)
+   */
+  bool requestFlush();
+
+  // ----------------------- Stats -------------------------
+  /** - Sequence number the next block will carry */
+  uint32_t nextSequence() const;
+  /** - Blocks written since begin() */
+  uint32_t blocksWritten() const;
+  /** - Samples dropped because both pages were pending */
+  uint32_t samplesDropped() const;
+  /** - Padding bytes written (sealed-before-full overhead) */
+  uint32_t paddingBytes() const;
+  /** - Write or sync errors */
+  uint32_t writeErrors() const;
+
+  // --------------------- Block helpers -------------------
+  /** - True if blk has the log magic and a matching CRC-32 */
+  static bool validBlock(const uint8_t *blk, uint16_t blockSize);
+  /** - CRC-32 (IEEE 802.3, reflected, init/xorout 0xFFFFFFFF) */
+  static uint32_t crc32(const uint8_t *p, size_t n);
+  /**
+   * - Parse a header block (block size is read from the block itself)
+   * - avail  : bytes available at blk
+   * - return : false if not a valid header block
+   */
+  static bool parseHeader(const uint8_t *blk, size_t avail, SCD4x_LogInfo_7Semi &info);
+  /**
+   * - Read the zone map of a sample block (CRC not checked here)
+   * - return : false if blk is not a sample block with a zone map
+   */
+  static bool readZone(const uint8_t *blk, uint16_t blockSize, SCD4x_LogZone_7Semi &zone);
+#if defined(ARDUINO)
+  /**
+   * - Fill info from the sensor (serial, variant, compensation, ASC)
+   * - Sensor must be idle (not in periodic measurement)
+   * - return : false if any read fails (info holds what was read)
+   */
+  static bool captureInfo(SCD4x_7Semi &sensor, SCD4x_LogInfo_7Semi &info);
+#endif
+
+private:
+  uint8_t *page[2];
+  uint16_t blockSize;           // in use (from the file header on reopen)
+  uint8_t  encoding;
+  uint16_t pageSize;            // constructor block size = page capacity
+  uint8_t  pageEncoding;        // constructor encoding, for new files
+  SCD4x_LogStorage_7Semi *storage = nullptr;
+  uint64_t serial = 0;
+  uint8_t  beginErr = BEGIN_OK;
+
+  bool failBegin(uint8_t why) {
+    beginErr = why;
+    return false;
+  }
+
+  // Producer side
+  uint8_t  active = 0;
+  uint16_t count = 0;
+  uint16_t used = 0;
+  uint32_t openedMs = 0;
+  SCD4x_DeltaEncoder_7Semi delta;
+  SCD4x_LogZone_7Semi zone;     // summary of the active page
+  uint16_t epoch = 0;           // t_ms wrap count
+  uint32_t lastMs = 0;
+  bool     haveLast = false;
+
+  // Hand-off: bit i set → page i sealed, waiting for service();
+  // SYNC_REQ → service() syncs after its next write (requestFlush())
+  static const uint8_t SYNC_REQ = 0x04;
+#if SCD4X_LOG_ATOMIC
+  std::atomic<uint8_t> sealed{ 0 };
+  uint8_t loadSealed() const { return sealed.load(std::memory_order_acquire); }
+  void markSealed(uint8_t bits) { sealed.fetch_or(bits, std::memory_order_release); }
+  void clearSealed(uint8_t bits) { sealed.fetch_and((uint8_t)~bits, std::memory_order_release); }
+  void resetSealed() { sealed.store(0, std::memory_order_release); }
+#else
+  volatile uint8_t sealed = 0;
+  uint8_t loadSealed() const { return sealed; }
+  void markSealed(uint8_t bits) { sealed |= bits; }
+  void clearSealed(uint8_t bits) { sealed &= (uint8_t)~bits; }
+  void resetSealed() { sealed = 0; }
+#endif
+
+  uint32_t pageOffset[2] = { 0, 0 };  // file offset assigned at seal
+
+  uint32_t seq = 0;
+  uint32_t offset = 0;
+  uint32_t maxAge = 0;
+  uint8_t  syncEvery = 1;
+  uint8_t  sinceSync = 0;
+  uint32_t nBlocks = 0;
+  uint32_t nDropped = 0;
+  uint32_t nPadding = 0;
+  uint32_t nErrors = 0;
+
+  /** - Write the header block at offset 0 (page[0] as scratch) */
+  bool writeHeader(const SCD4x_LogInfo_7Semi &info);
+  /** - Prepare the active page for new samples */
+  void openPage();
+  /** - Fill the common 24-byte block header */
+  void putHeader(uint8_t *b, uint8_t type) const;
+  /** - Fold one accepted sample into the active zone map */
+  void updateZone(const SCD4x_RawSample_7Semi &s);
+  /** - Finalise header + CRC of the active page and hand it off */
+  bool sealActive();
+  /** - Payload capacity per block */
+  uint16_t payloadCap() const;
+};
+
+#endif  // _7Semi_SCD4X_LOG_H
@@ -0,0 +1,113 @@
+/**
+ * 7Semi_SCD4x_Occupancy.cpp
+ * -------------------------
+ * Discrete single-zone CO₂ mass balance → generation rate → head count
+ *
+ * Implementation Notes
+ * --------------------
+ * - Solving V·dC/dt = G − Q·(C − C_out) for G, in mL/min:
+ *     G = V·60000·ΔC/Δt_ms  +  V·ACH100·(C − C_out)/6000
+ *   (V in m³, C in ppm; 1 m³·ppm = 1 mL)
+ * - C is kept in Q8 ppm; intermediates use int64 so V up to 65535 m³ cannot overflow.
+ * - Negative generation (window opened, ventilation under-estimated) is kept
+ *   in the filter state but clamped to 0 on output.
+ */
+
+#include "7Semi_SCD4x_Occupancy.h"
+
+/**
+- Construct estimator
+- volume_m3   : zone volume (m³)
+- ach_x100    : air changes per hour × 100
+- outdoor_ppm : outdoor CO₂ (ppm)
+*/
+SCD4x_Occupancy_7Semi::SCD4x_Occupancy_7Semi(uint16_t volume_m3, uint16_t ach_x100, uint16_t outdoor_ppm)
+  : volume(volume_m3), ach100(ach_x100), outdoor(outdoor_ppm) {}
+
+// ================= Configuration =================
+
+void SCD4x_Occupancy_7Semi::setVolume(uint16_t volume_m3) { volume = volume_m3; }
+
+void SCD4x_Occupancy_7Semi::setVentilation(uint16_t ach_x100) { ach100 = ach_x100; }
+
+void SCD4x_Occupancy_7Semi::setOutdoorPpm(uint16_t ppm) { outdoor = ppm; }
+
+void SCD4x_Occupancy_7Semi::setPerPersonRate(uint16_t ml_per_min) {
+  perPerson = ml_per_min ? ml_per_min : 1;
+}
+
+void SCD4x_Occupancy_7Semi::setFilterShift(uint8_t s) { shift = (s > 8) ? 8 : s; }
+
+void SCD4x_Occupancy_7Semi::reset() {
+  seeded = false;
+  cQ8 = 0;
+  gen = 0;
+}
+
+// ================= Update =================
+
+/**
+- Feed one CO₂ sample
+- co2_ppm : CO₂ in ppm
+- now_ms  : millis() at read time
+- return  : true when generation/occupancy outputs are valid
+*/
+bool SCD4x_Occupancy_7Semi::update(uint16_t co2_ppm, uint32_t now_ms) {
+  const int32_t xQ8 = (int32_t)co2_ppm << 8;
+  if (!seeded) {
+    cQ8 = xQ8;
+    gen = 0;
+    lastMs = now_ms;
+    seeded = true;
+    return false;
+  }
+
+  const uint32_t dt = now_ms - lastMs;
+  if (dt == 0) return true; // duplicate timestamp: keep previous estimate
+  lastMs = now_ms;
+
+  const int32_t prev = cQ8;
+  cQ8 = ema(cQ8, xQ8, shift);
+
+  // Accumulation term: V · 60000 · dC / dt_ms
+  int64_t g = (int64_t)volume * 60000 * (int64_t)(cQ8 - prev) / (int64_t)dt;
+  // Ventilation term: V · ACH100 · (C - C_out) / 6000
+  g += (int64_t)volume * ach100 * (int64_t)(cQ8 - ((int32_t)outdoor << 8)) / 6000;
+
+  if (g > INT32_MAX) g = INT32_MAX;
+  if (g < -INT32_MAX) g = -INT32_MAX;
+  gen = ema(gen, (int32_t)g, shift);
+  return true;
+}
+
+// ================= Outputs =================
+
+uint16_t SCD4x_Occupancy_7Semi::filteredPpm() const {
+  return (uint16_t)((cQ8 + 128) >> 8);
+}
+
+int32_t SCD4x_Occupancy_7Semi::generationMlPerMin() const {
+  return (gen > 0) ? ((gen + 128) >> 8) : 0;
+}
+
+uint32_t SCD4x_Occupancy_7Semi::occupancyQ8() const {
+  return (gen > 0) ? (uint32_t)gen / perPerson : 0;
+}
+
+uint16_t SCD4x_Occupancy_7Semi::occupancy() const {
+  return (uint16_t)((occupancyQ8() + 128) >> 8);
+}
+
+// ================= Helpers =================
+
+/**
+- Exponential moving average in fixed point
+- y     : previous output
+- x     : new input (same Q-format)
+- shift : alpha = 1/2^shift (0 → passthrough)
+*/
+int32_t SCD4x_Occupancy_7Semi::ema(int32_t y, int32_t x, uint8_t shift) {
+  if (shift == 0) return x;
+  // Divide (not shift) so negative steps round toward zero symmetrically
+  return y + (x - y) / (int32_t)(1L << shift);
+}
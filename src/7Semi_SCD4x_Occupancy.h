@@ -0,0 +1,106 @@
+#ifndef _7Semi_SCD4X_OCCUPANCY_H
+#define _7Semi_SCD4X_OCCUPANCY_H
+
+#include <Arduino.h>
+
+/**
+ * 7Semi_SCD4x_Occupancy.h
+ * -----------------------
+ * Occupancy estimation from the SCD4x CO₂ stream (single-zone mass balance)
+ *
+ * Model
+ * -----
+ *   V · dC/dt = G − Q · (C − C_out)
+ *
+ *   V     : room volume (m³)
+ *   Q     : outdoor-air flow, expressed as air changes per hour (ACH)
+ *   C     : indoor CO₂ (ppm), C_out : outdoor CO₂ (ppm)
+ *   G     : CO₂ generation rate → G / g_person = head count
+ *
+ * Notes
+ * -----
+ * - Integer / fixed-point only (Q8 ppm), constant memory, no allocation.
+ * - CO₂ is low-pass filtered (EMA, alpha = 1/2^shift) before differentiating;
+ *   the generation estimate is smoothed with a second EMA of the same shift.
+ * - Default g_person = 312 mL/min (≈0.0052 L/s, seated office work).
+ * - Feed one sample per readMeasurement(); dt is taken from the caller's clock.
+ *
+ * Accuracy (extras/host/occupancy_bench.cpp)
+ * ------------------------------------------
+ * - Bound checked on a simulated 120 m³ zone with SCD41-like noise, after
+ *   a step in or out or an ACH change: within 0.5 person of the truth by
+ *   20 min after the change (typically 5), then mean error ≤ 0.5 and RMS
+ *   error ≤ 1 person.
+ * - Model mismatch: with k = (V · ACH assumed) / (V · ACH true) the
+ *   estimate tends to k × the head count, and the bound widens by
+ *   |k − 1| × head count. Checked with V set 20 % low (reads 20 % low)
+ *   and with ACH changes not passed to setVentilation() (1.2 → 4 ACH with
+ *   3 people reads ~0.7; 1.2 → 0.6 ACH with 5 people heads for 10).
+ * - The filter must match the cadence: shift 4 (default) for periodic
+ *   5 s samples, shift 2 for low-power 30 s. Shift 2 at 5 s passes sensor
+ *   noise through the derivative (RMS 3–4 persons).
+ */
+
+class SCD4x_Occupancy_7Semi {
+public:
+  /**
+   * - Construct estimator for one ventilated zone
+   * - volume_m3     : room volume in m³
+   * - ach_x100      : ventilation in air changes per hour × 100 (e.g. 150 = 1.5 ACH)
+   * - outdoor_ppm   : outdoor / supply-air CO₂ in ppm
+   */
+  SCD4x_Occupancy_7Semi(uint16_t volume_m3 = 50, uint16_t ach_x100 = 100, uint16_t outdoor_ppm = 420);
+
+  // -------------------- Configuration --------------------
+  /** - Set room volume in m³ */
+  void setVolume(uint16_t volume_m3);
+  /** - Set ventilation rate in ACH × 100 */
+  void setVentilation(uint16_t ach_x100);
+  /** - Set outdoor CO₂ in ppm */
+  void setOutdoorPpm(uint16_t ppm);
+  /** - Set per-person CO₂ generation in mL/min (default 312) */
+  void setPerPersonRate(uint16_t ml_per_min);
+  /**
+   * - Set EMA shift for CO₂ and generation filters (alpha = 1/2^shift, 0..8)
+   * - 4 (default) for 5 s periodic samples, 2 for 30 s low-power
+   */
+  void setFilterShift(uint8_t shift);
+  /** - Forget filter state; next sample re-seeds the model */
+  void reset();
+
+  // ---------------------- Update ------------------------
+  /**
+   * - Feed one CO₂ sample
+   * - co2_ppm : CO₂ from readMeasurement()
+   * - now_ms  : sample timestamp (millis())
+   * - return  : true once a generation estimate is available (second sample on)
+   */
+  bool update(uint16_t co2_ppm, uint32_t now_ms);
+
+  // ---------------------- Outputs ------------------------
+  /** - Filtered CO₂ in ppm */
+  uint16_t filteredPpm() const;
+  /** - Estimated CO₂ generation in mL/min (≥ 0) */
+  int32_t generationMlPerMin() const;
+  /** - Estimated occupancy in persons, Q8 fixed-point (256 = 1 person) */
+  uint32_t occupancyQ8() const;
+  /** - Estimated occupancy rounded to whole persons */
+  uint16_t occupancy() const;
+
+private:
+  uint16_t volume;        // m³
+  uint16_t ach100;        // ACH × 100
+  uint16_t outdoor;       // ppm
+  uint16_t perPerson = 312;
+  uint8_t  shift = 4;
+
+  bool     seeded = false;
+  uint32_t lastMs = 0;
+  int32_t  cQ8 = 0;       // filtered CO₂, ppm Q8
+  int32_t  gen = 0;       // filtered generation, mL/min Q8
+
+  /** - EMA step in Q8: y += (x - y) >> shift */
+  static int32_t ema(int32_t y, int32_t x, uint8_t shift);
+};
+
+#endif  // _7Semi_SCD4X_OCCUPANCY_H
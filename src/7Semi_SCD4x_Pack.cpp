@@ -0,0 +1,179 @@
+/**
+ * 7Semi_SCD4x_Pack.cpp
+ * --------------------
+ * Bit-packed uplink frame encoder / decoder
+ *
+ * Implementation Notes
+ * --------------------
+ * - BitWriter / BitReader are MSB-first over a byte buffer with bounds checks;
+ *   a write past cap or read past len marks the stream bad instead of faulting.
+ * - Delta widths are chosen per frame from the largest zigzag delta, so a
+ *   steady room costs a few bits per extra sample and a jump costs only that frame.
+ */
+
+#include "7Semi_SCD4x_Pack.h"
+
+namespace {
+
+struct BitWriter {
+  uint8_t *buf;
+  size_t   cap;
+  size_t   bit = 0;
+  bool     ok = true;
+
+  BitWriter(uint8_t *b, size_t c) : buf(b), cap(c) {}
+
+  void put(uint32_t v, uint8_t bits) {
+    while (bits--) {
+      const size_t byte = bit >> 3;
+      if (byte >= cap) { ok = false; return; }
+      const uint8_t mask = (uint8_t)(0x80 >> (bit & 7));
+      if (v & (1UL << bits)) buf[byte] |= mask;
+      else buf[byte] &= (uint8_t)~mask;
+      ++bit;
+    }
+  }
+  size_t bytes() const { return (bit + 7) >> 3; }
+};
+
+struct BitReader {
+  const uint8_t *buf;
+  size_t len;
+  size_t bit = 0;
+  bool   ok = true;
+
+  BitReader(const uint8_t *b, size_t l) : buf(b), len(l) {}
+
+  uint32_t get(uint8_t bits) {
+    uint32_t v = 0;
+    while (bits--) {
+      const size_t byte = bit >> 3;
+      if (byte >= len) { ok = false; return 0; }
+      v = (v << 1) | ((buf[byte] >> (7 - (bit & 7))) & 1);
+      ++bit;
+    }
+    return v;
+  }
+};
+
+inline uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+
+inline int32_t unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+inline uint8_t bitWidth(uint32_t v) {
+  uint8_t w = 0;
+  while (v) { ++w; v >>= 1; }
+  return w;
+}
+
+inline uint8_t clampBits(uint8_t b, uint8_t lo, uint8_t hi) { return b < lo ? lo : (b > hi ? hi : b); }
+
+}  // namespace
+
+/**
+- Construct with field layout (widths clamped to valid ranges)
+*/
+SCD4x_Pack_7Semi::SCD4x_Pack_7Semi(const SCD4x_PackConfig_7Semi &c) : cfg(c) {
+  cfg.co2Bits = clampBits(cfg.co2Bits, 1, 16);
+  cfg.tBits = clampBits(cfg.tBits, 1, 16);
+  cfg.rhBits = clampBits(cfg.rhBits, 1, 16);
+  cfg.seqBits = clampBits(cfg.seqBits, 0, 16);
+  cfg.flagBits = clampBits(cfg.flagBits, 0, 8);
+}
+
+/**
+- Encode n samples into one frame
+*/
+size_t SCD4x_Pack_7Semi::encode(const SCD4x_RawSample_7Semi *s, uint8_t n, uint16_t seq, uint8_t flags,
+                                uint8_t *out, size_t cap) const {
+  if (!s || n == 0 || n > SCD4X_PACK_MAX_SAMPLES) return 0;
+
+  // Quantise all channels first (≤ 16 samples on the stack)
+  const uint16_t co2Max = (uint16_t)((1UL << cfg.co2Bits) - 1);
+  uint16_t q[SCD4X_PACK_MAX_SAMPLES][3];
+  for (uint8_t i = 0; i < n; ++i) {
+    q[i][0] = (s[i].co2_raw > co2Max) ? co2Max : s[i].co2_raw;
+    q[i][1] = truncate(s[i].t_raw, cfg.tBits);
+    q[i][2] = truncate(s[i].rh_raw, cfg.rhBits);
+  }
+
+  BitWriter w(out, cap);
+  w.put(n - 1, 4);
+  w.put(seq, cfg.seqBits);
+  w.put(flags, cfg.flagBits);
+  w.put(q[0][0], cfg.co2Bits);
+  w.put(q[0][1], cfg.tBits);
+  w.put(q[0][2], cfg.rhBits);
+
+  if (n > 1) {
+    uint8_t width[3] = { 0, 0, 0 };
+    for (uint8_t i = 1; i < n; ++i)
+      for (uint8_t c = 0; c < 3; ++c) {
+        uint8_t b = bitWidth(zigzag((int32_t)q[i][c] - q[i - 1][c]));
+        if (b > width[c]) width[c] = b;
+      }
+    for (uint8_t c = 0; c < 3; ++c) w.put(width[c], 5);
+    for (uint8_t i = 1; i < n; ++i)
+      for (uint8_t c = 0; c < 3; ++c)
+        w.put(zigzag((int32_t)q[i][c] - q[i - 1][c]), width[c]);
+  }
+
+  if (!w.ok) return 0;
+  // Zero the padding bits of the last byte
+  if (w.bit & 7) out[w.bit >> 3] &= (uint8_t)(0xFF << (8 - (w.bit & 7)));
+  return w.bytes();
+}
+
+/**
+- Decode one frame
+*/
+uint8_t SCD4x_Pack_7Semi::decode(const uint8_t *in, size_t len, SCD4x_RawSample_7Semi *out, uint8_t max,
+                                 uint16_t &seq, uint8_t &flags) const {
+  BitReader r(in, len);
+  const uint8_t n = (uint8_t)(r.get(4) + 1);
+  seq = (uint16_t)r.get(cfg.seqBits);
+  flags = (uint8_t)r.get(cfg.flagBits);
+  uint16_t cur[3];
+  cur[0] = (uint16_t)r.get(cfg.co2Bits);
+  cur[1] = (uint16_t)r.get(cfg.tBits);
+  cur[2] = (uint16_t)r.get(cfg.rhBits);
+  if (!r.ok || n > max) return 0;
+
+  uint8_t width[3] = { 0, 0, 0 };
+  if (n > 1)
+    for (uint8_t c = 0; c < 3; ++c) width[c] = (uint8_t)r.get(5);
+
+  for (uint8_t i = 0; i < n; ++i) {
+    if (i > 0)
+      for (uint8_t c = 0; c < 3; ++c) {
+        if (width[c] > 17) return 0;
+        cur[c] = (uint16_t)(cur[c] + unzigzag(r.get(width[c])));
+      }
+    if (!r.ok) return 0;
+    out[i].t_ms = i;
+    out[i].co2_raw = cur[0];
+    out[i].t_raw = restore(cur[1], cfg.tBits);
+    out[i].rh_raw = restore(cur[2], cfg.rhBits);
+  }
+  return n;
+}
+
+/**
+- Worst case: every delta at 17 bits
+*/
+size_t SCD4x_Pack_7Semi::maxFrameBytes(uint8_t n) const {
+  size_t bits = 4 + cfg.seqBits + cfg.flagBits + cfg.co2Bits + cfg.tBits + cfg.rhBits;
+  if (n > 1) bits += 15 + (size_t)(n - 1) * 3 * 17;
+  return (bits + 7) >> 3;
+}
+
+// ================= Helpers =================
+
+uint16_t SCD4x_Pack_7Semi::truncate(uint16_t raw, uint8_t bits) {
+  return (uint16_t)(raw >> (16 - bits));
+}
+
+uint16_t SCD4x_Pack_7Semi::restore(uint16_t v, uint8_t bits) {
+  if (bits >= 16) return v;
+  return (uint16_t)((v << (16 - bits)) | (1U << (15 - bits)));
+}
@@ -0,0 +1,76 @@
+#ifndef _7Semi_SCD4X_PACK_H
+#define _7Semi_SCD4X_PACK_H
+
+#include "7Semi_SCD4x_Sample.h"
+
+/**
+ * 7Semi_SCD4x_Pack.h
+ * ------------------
+ * Bit-exact compact uplink frames (LoRa / cellular) for SCD4x samples
+ *
+ * Frame layout (MSB-first bit stream, zero-padded to a byte)
+ * -----------------------------------------------------------
+ *   count − 1          4 bits   (1..16 samples)
+ *   sequence           seqBits
+ *   status flags       flagBits
+ *   sample 0           co2Bits | tBits | rhBits   (absolute)
+ *   if count > 1:
+ *     widths           3 × 5 bits (delta width per channel, 0..17)
+ *     samples 1..n−1   zz(Δco2) | zz(Δt) | zz(Δrh) at those widths
+ *
+ * Notes
+ * -----
+ * - T / RH keep the top tBits / rhBits of the raw word; decode restores the
+ *   mid-point of the dropped range (max error ½ of the kept LSB).
+ * - CO₂ saturates at 2^co2Bits − 1.
+ * - Timestamps are not sent: samples in a frame are one measurement period
+ *   apart and the sequence number orders frames. Decoded t_ms is the index.
+ * - Both sides must use the same SCD4x_PackConfig_7Semi.
+ * - Encode / decode work on caller buffers only (no heap), MCU and host.
+ */
+
+#define SCD4X_PACK_MAX_SAMPLES 16
+
+struct SCD4x_PackConfig_7Semi {
+  uint8_t co2Bits  = 16;  // 1..16
+  uint8_t tBits    = 12;  // 1..16 (12 → 0.043 °C)
+  uint8_t rhBits   = 10;  // 1..16 (10 → 0.098 %RH)
+  uint8_t seqBits  = 8;   // 0..16
+  uint8_t flagBits = 4;   // 0..8
+};
+
+class SCD4x_Pack_7Semi {
+public:
+  /** - Construct with a field layout */
+  explicit SCD4x_Pack_7Semi(const SCD4x_PackConfig_7Semi &cfg = SCD4x_PackConfig_7Semi());
+
+  /**
+   * - Encode n samples into one frame
+   * - s     : samples (n = 1..16)
+   * - seq   : sequence number (truncated to seqBits)
+   * - flags : status flags (truncated to flagBits)
+   * - out   : frame buffer, cap bytes
+   * - return: frame length in bytes (0 if n invalid or buffer too small)
+   */
+  size_t encode(const SCD4x_RawSample_7Semi *s, uint8_t n, uint16_t seq, uint8_t flags,
+                uint8_t *out, size_t cap) const;
+  /**
+   * - Decode one frame
+   * - out   : receives up to max samples
+   * - return: samples decoded (0 on truncated / malformed frame)
+   */
+  uint8_t decode(const uint8_t *in, size_t len, SCD4x_RawSample_7Semi *out, uint8_t max,
+                 uint16_t &seq, uint8_t &flags) const;
+  /** - Worst-case frame size in bytes for n samples */
+  size_t maxFrameBytes(uint8_t n) const;
+
+private:
+  SCD4x_PackConfig_7Semi cfg;
+
+  /** - Keep top `bits` of a 16-bit raw word */
+  static uint16_t truncate(uint16_t raw, uint8_t bits);
+  /** - Restore a truncated word to the mid-point of its range */
+  static uint16_t restore(uint16_t v, uint8_t bits);
+};
+
+#endif  // _7Semi_SCD4X_PACK_H
@@ -0,0 +1,149 @@
+/**
+ * 7Semi_SCD4x_Pressure.cpp
+ * ------------------------
+ * Barometer-driven CO₂ pressure compensation with a bounded sensor fallback
+ *
+ * Implementation Notes
+ * --------------------
+ * - Pressures are held in 10 Pa steps and limited to 30–110 kPa, so the
+ *   ratio p_ref · 2¹⁴ / p stays below 2¹⁶ and (ratio − 1) · k (k ≤ 4)
+ *   fits 32 bits without 64-bit arithmetic (AVR).
+ * - Readings outside that range are rejected before any state changes.
+ * - Gains are recomputed only when the barometer or the reference changes;
+ *   compensate() is one 32-bit multiply and shift per sample.
+ * - A failed push also starts the rate-limit interval, so a sensor that
+ *   rejects the write is not retried on every barometer reading.
+ * - millis() wraps every ~49 days; all comparisons use signed differences.
+ */
+
+#include "7Semi_SCD4x_Pressure.h"
+
+#define SCD4X_PRESSURE_STD_DPA  10132   // 101325 Pa, 10 Pa steps
+#define SCD4X_PRESSURE_MIN_PA   30000UL // plausible barometer range
+#define SCD4X_PRESSURE_MAX_PA   110000UL
+#define SCD4X_PRESSURE_MAX_K    1024    // sensitivity cap (Q8, k = 4)
+
+// ================= Setup =================
+
+SCD4x_Pressure_7Semi::SCD4x_Pressure_7Semi(SCD4x_7Semi *sensor)
+  : dev(sensor), liveDpa(0), refDpa(SCD4X_PRESSURE_STD_DPA),
+    prevRefDpa(SCD4X_PRESSURE_STD_DPA) {
+  memset(&st, 0, sizeof(st));
+}
+
+/**
+- p = 101325 · (1 − 2.25577e-5 · h)^5.25588 (standard atmosphere)
+*/
+void SCD4x_Pressure_7Semi::setReferenceAltitude(uint16_t meters) {
+  const float p = 101325.0f * powf(1.0f - 2.25577e-5f * (float)meters, 5.25588f);
+  setReferencePressure((uint32_t)(p + 0.5f));
+}
+
+void SCD4x_Pressure_7Semi::setReferencePressure(uint32_t pa) {
+  if (pa < SCD4X_PRESSURE_MIN_PA || pa > SCD4X_PRESSURE_MAX_PA) return;
+  refDpa = prevRefDpa = (uint16_t)((pa + 5) / 10);
+  attempted = false;
+  recompute();
+}
+
+void SCD4x_Pressure_7Semi::setSensitivity(uint16_t k_q8) {
+  kQ8 = k_q8 > SCD4X_PRESSURE_MAX_K ? SCD4X_PRESSURE_MAX_K : k_q8;
+  recompute();
+}
+
+void SCD4x_Pressure_7Semi::setFallback(uint32_t drift_pa, uint32_t min_interval_ms) {
+  driftPa = drift_pa;
+  minIntervalMs = min_interval_ms;
+}
+
+void SCD4x_Pressure_7Semi::setMeasurementPeriod(uint32_t ms) { periodMs = ms; }
+
+void SCD4x_Pressure_7Semi::resetStats() { memset(&st, 0, sizeof(st)); }
+
+// ================= Barometer =================
+
+bool SCD4x_Pressure_7Semi::update(uint32_t pa, uint32_t now_ms) {
+  if (pa < SCD4X_PRESSURE_MIN_PA || pa > SCD4X_PRESSURE_MAX_PA) {
+    ++st.rejected;
+    return false;
+  }
+  ++st.updates;
+  liveDpa = (uint16_t)((pa + 5) / 10);
+  recompute();
+  if (!dev) return false;
+
+  const int32_t hpa = pushDue(now_ms);
+  if (hpa < 0) return false;
+  if (!dev->setAmbientPressureRaw((uint16_t)hpa)) {
+    ++st.pushFailures;
+    lastPushMs = now_ms;
+    attempted = true;
+    return false;
+  }
+  pushed((uint16_t)hpa, now_ms);
+  return true;
+}
+
+// ================= Compensation =================
+
+uint16_t SCD4x_Pressure_7Semi::compensate(uint16_t co2_ppm) const { return apply(co2_ppm, gain); }
+
+/**
+- Samples read within one period of a push were measured with the old reference
+*/
+uint16_t SCD4x_Pressure_7Semi::compensate(const SCD4x_RawSample_7Semi &s) const {
+  const bool old = st.pushes && (int32_t)(s.t_ms - switchMs) < 0;
+  return apply(s.co2_raw, old ? prevGain : gain);
+}
+
+// ================= Manual pushes =================
+
+/**
+- Due when |p − p_ref| ≥ driftPa, the hPa value changes and the interval has passed
+*/
+int32_t SCD4x_Pressure_7Semi::pushDue(uint32_t now_ms) {
+  if (!driftPa) return -1;
+  const int32_t d = (int32_t)liveDpa - (int32_t)refDpa;
+  if ((uint32_t)(d < 0 ? -d : d) * 10UL < driftPa) return -1;
+  const uint16_t hpa = (uint16_t)((liveDpa + 5) / 10);
+  if (hpa * 10U == refDpa) return -1;
+  if (attempted && (int32_t)(now_ms - lastPushMs) < (int32_t)minIntervalMs) {
+    ++st.held;
+    return -1;
+  }
+  return hpa;
+}
+
+void SCD4x_Pressure_7Semi::pushed(uint16_t hpa, uint32_t now_ms) {
+  ++st.pushes;
+  prevRefDpa = refDpa;
+  refDpa = (uint16_t)(hpa * 10U);
+  lastPushMs = now_ms;
+  switchMs = now_ms + periodMs;
+  attempted = true;
+  recompute();
+}
+
+// ================= Internals =================
+
+void SCD4x_Pressure_7Semi::recompute() {
+  gain = gainFor(refDpa);
+  prevGain = gainFor(prevRefDpa);
+}
+
+/**
+- gain = 1 + k · (p_ref / p − 1), Q14, clamped to [0.5, 2)
+*/
+uint16_t SCD4x_Pressure_7Semi::gainFor(uint16_t ref_dpa) const {
+  if (!liveDpa) return 16384;
+  const int32_t ratio = (int32_t)((((uint32_t)ref_dpa << 14) + liveDpa / 2) / liveDpa);
+  int32_t g = 16384 + (((ratio - 16384) * (int32_t)kQ8) >> 8);
+  if (g < 8192) g = 8192;
+  if (g > 32767) g = 32767;
+  return (uint16_t)g;
+}
+
+uint16_t SCD4x_Pressure_7Semi::apply(uint16_t ppm, uint16_t gain_q14) {
+  const uint32_t v = ((uint32_t)ppm * gain_q14 + 8192UL) >> 14;
+  return v > 65535UL ? 65535 : (uint16_t)v;
+}
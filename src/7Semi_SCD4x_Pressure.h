@@ -0,0 +1,133 @@
+#ifndef _7Semi_SCD4X_PRESSURE_H
+#define _7Semi_SCD4X_PRESSURE_H
+
+#include <Arduino.h>
+#include "7Semi_SCD4x.h"
+#include "7Semi_SCD4x_Sample.h"
+
+/**
+ * 7Semi_SCD4x_Pressure.h
+ * ----------------------
+ * Software CO₂ pressure compensation from a barometer, so live pressure
+ * updates cost no I²C writes
+ *
+ * Model
+ * -----
+ * - The sensor compensates every sample for its reference pressure p_ref:
+ *   the last set_ambient_pressure value, else the pressure of the
+ *   configured altitude. NDIR absorption scales with CO₂ density, so a
+ *   sample taken at live pressure p is corrected as
+ *     ppm = ppm_sensor · (1 + k · (p_ref / p − 1))
+ *   k = 1 (Q8 256) is the ideal-gas ratio; setSensitivity() trims it
+ *   against a reference instrument.
+ * - Integer only: pressures in 10 Pa steps, gain Q14 (16384 = 1.0),
+ *   recomputed on update(), not per sample.
+ *
+ * Fallback
+ * --------
+ * - The ratio is exact to first order; the sensor's own model differs
+ *   from it by a term that grows with |p − p_ref|. When the live pressure
+ *   drifts more than driftPa from p_ref, the rounded hPa value is pushed
+ *   with setAmbientPressureRaw() (accepted while measuring), at most once
+ *   per minIntervalMs, and p_ref follows it.
+ * - The sample in flight when a push lands was compensated for the old
+ *   p_ref; compensate(sample) uses the old gain until one measurement
+ *   period after the push.
+ * - Without a driver (e.g. behind SCD4x_Queue_7Semi) poll pushDue() and
+ *   report the write with pushed().
+ *
+ * Notes
+ * -----
+ * - Ambient pressure is volatile on the sensor: after a power cycle or
+ *   reinit the reference is the altitude again (setReferenceAltitude()).
+ * - Altitude → pressure uses the standard barometric formula; 0 m gives
+ *   101325 Pa (the sensor's 101300 Pa default differs by 0.02 %).
+ */
+
+/** - Compensation and fallback counters */
+struct SCD4x_PressureStats_7Semi {
+  uint32_t updates;       // barometer readings fed
+  uint32_t pushes;        // setAmbientPressureRaw() writes
+  uint32_t pushFailures;  // writes the sensor rejected
+  uint32_t held;          // pushes due but held back by the rate limit
+  uint32_t rejected;      // readings outside 30–110 kPa, ignored
+};
+
+class SCD4x_Pressure_7Semi {
+public:
+  /**
+   * - sensor : driver used for fallback pushes (nullptr = caller pushes
+   *            via pushDue() / pushed(), or never with setFallback(0, 0))
+   */
+  explicit SCD4x_Pressure_7Semi(SCD4x_7Semi *sensor = nullptr);
+
+  // -------------------- Configuration --------------------
+  /** - Sensor reference from its altitude setting (no pressure set) */
+  void setReferenceAltitude(uint16_t meters);
+  /** - Sensor reference set elsewhere (setAmbientPressureRaw(), in Pa; 30–110 kPa) */
+  void setReferencePressure(uint32_t pa);
+  /** - Pressure sensitivity, Q8 (256 = ideal gas, capped at 1024) */
+  void setSensitivity(uint16_t k_q8);
+  /**
+   * - Push threshold and rate limit
+   * - drift_pa        : |p − p_ref| that triggers a push (0 = never push)
+   * - min_interval_ms : minimum time between pushes
+   */
+  void setFallback(uint32_t drift_pa, uint32_t min_interval_ms);
+  /** - Measurement period (5000 periodic, 30000 low power), for push hand-over */
+  void setMeasurementPeriod(uint32_t ms);
+
+  // ----------------------- Barometer ----------------------
+  /**
+   * - Feed one barometer reading
+   * - pa     : pressure in Pa; outside 30–110 kPa the reading is rejected
+   *            and gain / fallback state stay as they were
+   * - now_ms : millis()
+   * - return : true if a fallback push was written
+   */
+  bool update(uint32_t pa, uint32_t now_ms);
+
+  // ---------------------- Compensation --------------------
+  /** - Compensate CO₂ (ppm) with the current gain */
+  uint16_t compensate(uint16_t co2_ppm) const;
+  /** - Compensate a sample, using the gain in force when it was measured */
+  uint16_t compensate(const SCD4x_RawSample_7Semi &sample) const;
+
+  // --------------------- Manual pushes --------------------
+  /** - hPa to write now, or −1 if no push is due (driverless use) */
+  int32_t pushDue(uint32_t now_ms);
+  /** - Report a completed setAmbientPressureRaw(hpa) */
+  void pushed(uint16_t hpa, uint32_t now_ms);
+
+  /** - Last barometer reading (Pa, 0 = none yet: gain stays 1.0) */
+  uint32_t pressure() const { return (uint32_t)liveDpa * 10UL; }
+  /** - Sensor reference pressure (Pa) */
+  uint32_t reference() const { return (uint32_t)refDpa * 10UL; }
+  /** - Current CO₂ gain, Q14 */
+  uint16_t gainQ14() const { return gain; }
+  const SCD4x_PressureStats_7Semi &stats() const { return st; }
+  void resetStats();
+
+private:
+  SCD4x_7Semi *dev;
+  SCD4x_PressureStats_7Semi st;
+
+  uint16_t liveDpa;              // 10 Pa steps, 0 = no reading
+  uint16_t refDpa;
+  uint16_t prevRefDpa;           // reference before the last push
+  uint16_t kQ8 = 256;
+  uint16_t gain = 16384;         // for refDpa
+  uint16_t prevGain = 16384;     // for prevRefDpa
+  uint32_t driftPa = 1000;
+  uint32_t minIntervalMs = 60000;
+  uint32_t periodMs = 5000;
+  uint32_t lastPushMs = 0;       // last push attempt
+  uint32_t switchMs = 0;         // first sample time with the new reference
+  bool attempted = false;
+
+  void recompute();
+  uint16_t gainFor(uint16_t ref_dpa) const;
+  static uint16_t apply(uint16_t ppm, uint16_t gain_q14);
+};
+
+#endif  // _7Semi_SCD4X_PRESSURE_H
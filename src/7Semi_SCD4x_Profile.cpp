@@ -0,0 +1,208 @@
+/**
+ * 7Semi_SCD4x_Profile.cpp
+ * -----------------------
+ * CRC-protected per-serial profile slots and the boot-time diff-apply
+ *
+ * Implementation Notes
+ * --------------------
+ * - Slots are self-contained (magic, version, CRC each), so there is no
+ *   directory to keep consistent: a torn write loses at most that slot.
+ * - save() compares the packed slot with what is stored and writes only
+ *   on a difference; the EEPROM adapter additionally skips unchanged
+ *   bytes, and flash-backed EEPROM is committed only after a real write.
+ * - restore() reads each on-sensor setting before writing it. If the very
+ *   first read fails the sensor may still be finishing a stop (500 ms),
+ *   so it waits once and retries.
+ * - persist_settings needs 800 ms before the next command; restore()
+ *   waits it out (boot path, blocking is acceptable there).
+ */
+
+#include "7Semi_SCD4x_Profile.h"
+
+// ================= Setup =================
+
+SCD4x_ProfileStore_7Semi::SCD4x_ProfileStore_7Semi(SCD4x_ProfileStorage_7Semi &storage, uint32_t b, uint8_t n)
+  : st(&storage), base(b), slots(n) {}
+
+// ================= Storage =================
+
+bool SCD4x_ProfileStore_7Semi::find(uint64_t serial, SCD4x_Profile_7Semi &out) {
+  uint8_t slot[SCD4X_PROFILE_SLOT_LEN];
+  for (uint8_t i = 0; i < slots; ++i) {
+    if (!st->read(base + (uint32_t)i * SCD4X_PROFILE_SLOT_LEN, slot, sizeof(slot))) return false;
+    if (unpack(slot, out) && out.serial == serial) return true;
+  }
+  return false;
+}
+
+/**
+- Same serial reuses its slot; identical content writes nothing
+*/
+bool SCD4x_ProfileStore_7Semi::save(const SCD4x_Profile_7Semi &p) {
+  int16_t free = -1;
+  int16_t i = locate(p.serial, free);
+  if (i < 0) i = free;
+  if (i < 0) return false;
+
+  uint8_t want[SCD4X_PROFILE_SLOT_LEN], have[SCD4X_PROFILE_SLOT_LEN];
+  pack(p, want);
+  if (!st->read(base + (uint32_t)i * SCD4X_PROFILE_SLOT_LEN, have, sizeof(have))) return false;
+  if (memcmp(want, have, sizeof(want)) == 0) return true;
+  return writeSlot((uint8_t)i, want);
+}
+
+bool SCD4x_ProfileStore_7Semi::erase(uint64_t serial) {
+  int16_t free = -1;
+  const int16_t i = locate(serial, free);
+  if (i < 0) return true;
+  uint8_t blank[SCD4X_PROFILE_SLOT_LEN];
+  memset(blank, 0xFF, sizeof(blank));
+  return writeSlot((uint8_t)i, blank);
+}
+
+uint8_t SCD4x_ProfileStore_7Semi::count() {
+  uint8_t slot[SCD4X_PROFILE_SLOT_LEN];
+  SCD4x_Profile_7Semi p;
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < slots; ++i) {
+    if (!st->read(base + (uint32_t)i * SCD4X_PROFILE_SLOT_LEN, slot, sizeof(slot))) break;
+    if (unpack(slot, p)) ++n;
+  }
+  return n;
+}
+
+int16_t SCD4x_ProfileStore_7Semi::locate(uint64_t serial, int16_t &free) {
+  uint8_t slot[SCD4X_PROFILE_SLOT_LEN];
+  SCD4x_Profile_7Semi p;
+  free = -1;
+  for (uint8_t i = 0; i < slots; ++i) {
+    if (!st->read(base + (uint32_t)i * SCD4X_PROFILE_SLOT_LEN, slot, sizeof(slot))) return -1;
+    if (!unpack(slot, p)) {
+      if (free < 0) free = i;
+      continue;
+    }
+    if (p.serial == serial) return i;
+  }
+  return -1;
+}
+
+bool SCD4x_ProfileStore_7Semi::writeSlot(uint8_t i, const uint8_t *slot) {
+  if (!st->write(base + (uint32_t)i * SCD4X_PROFILE_SLOT_LEN, slot, SCD4X_PROFILE_SLOT_LEN)) return false;
+  nBytes += SCD4X_PROFILE_SLOT_LEN;
+  return st->sync();
+}
+
+// ================= Boot restore =================
+
+static uint8_t restoreHook(SCD4x_ProfileStore_7Semi *store, SCD4x_7Semi &dev, uint64_t serial) {
+  return store->restore(dev, serial);
+}
+
+/**
+- Driver side: installs the hook begin() calls, keeping the core driver
+  free of a link dependency on this file
+*/
+void SCD4x_7Semi::setProfileStore(SCD4x_ProfileStore_7Semi *store) {
+  profileStore = store;
+  profileRestore = store ? restoreHook : nullptr;
+}
+
+/**
+- Look up serial, then write only the on-sensor settings that differ
+*/
+uint8_t SCD4x_ProfileStore_7Semi::restore(SCD4x_7Semi &dev, uint64_t serial) {
+  changed = 0;
+  haveProf = find(serial, prof);
+  if (!haveProf) return result = NONE;
+
+  // The first read after begin() may hit the tail of a stop: retry once
+  bool first = true;
+  uint16_t cur = 0;
+  if (prof.flags & SCD4X_PROFILE_TEMP_OFFSET) {
+    bool ok = dev.getTemperatureOffsetRaw(cur);
+    if (!ok && first) {
+      delay(500);
+      ok = dev.getTemperatureOffsetRaw(cur);
+    }
+    first = false;
+    if (!ok) return result = FAILED;
+    if (cur != prof.tempOffsetRaw) {
+      if (!dev.setTemperatureOffsetRaw(prof.tempOffsetRaw)) return result = FAILED;
+      changed |= SCD4X_PROFILE_TEMP_OFFSET;
+      delay(1);
+    }
+  }
+  if (prof.flags & SCD4X_PROFILE_ALTITUDE) {
+    bool ok = dev.getSensorAltitude(cur);
+    if (!ok && first) {
+      delay(500);
+      ok = dev.getSensorAltitude(cur);
+    }
+    if (!ok) return result = FAILED;
+    if (cur != prof.altitudeM) {
+      if (!dev.setSensorAltitude(prof.altitudeM)) return result = FAILED;
+      changed |= SCD4X_PROFILE_ALTITUDE;
+      delay(1);
+    }
+  }
+
+  if (!changed) return result = UNCHANGED;
+  if (!dev.persistSettings()) return result = FAILED;
+  ++nPersists;
+  delay(800);  // persist_settings execution time
+  return result = APPLIED;
+}
+
+// ================= Codec =================
+
+/**
+- Profile → 28-byte slot (little-endian, CRC last)
+*/
+void SCD4x_ProfileStore_7Semi::pack(const SCD4x_Profile_7Semi &p, uint8_t *s) {
+  s[0] = SCD4X_PROFILE_MAGIC;
+  s[1] = SCD4X_PROFILE_VERSION;
+  for (uint8_t i = 0; i < 6; ++i) s[2 + i] = (uint8_t)(p.serial >> (8 * i));
+  s[8] = p.flags;
+  s[9] = 0;
+  const uint16_t w[8] = { p.tempOffsetRaw, p.altitudeM, p.co2GainQ14, (uint16_t)p.co2OffsetPpm,
+                          (uint16_t)p.selfHeatStd, (uint16_t)p.selfHeatLp,
+                          (uint16_t)p.selfHeatSlopeStd, (uint16_t)p.selfHeatSlopeLp };
+  for (uint8_t i = 0; i < 8; ++i) {
+    s[10 + 2 * i] = (uint8_t)w[i];
+    s[11 + 2 * i] = (uint8_t)(w[i] >> 8);
+  }
+  const uint16_t crc = crc16(s, SCD4X_PROFILE_SLOT_LEN - 2);
+  s[26] = (uint8_t)crc;
+  s[27] = (uint8_t)(crc >> 8);
+}
+
+bool SCD4x_ProfileStore_7Semi::unpack(const uint8_t *s, SCD4x_Profile_7Semi &p) {
+  if (s[0] != SCD4X_PROFILE_MAGIC || s[1] != SCD4X_PROFILE_VERSION) return false;
+  if (crc16(s, SCD4X_PROFILE_SLOT_LEN - 2) != (uint16_t)(s[26] | (uint16_t)s[27] << 8)) return false;
+  p.serial = 0;
+  for (uint8_t i = 0; i < 6; ++i) p.serial |= (uint64_t)s[2 + i] << (8 * i);
+  p.flags = s[8];
+  uint16_t w[8];
+  for (uint8_t i = 0; i < 8; ++i) w[i] = (uint16_t)(s[10 + 2 * i] | (uint16_t)s[11 + 2 * i] << 8);
+  p.tempOffsetRaw = w[0];
+  p.altitudeM = w[1];
+  p.co2GainQ14 = w[2];
+  p.co2OffsetPpm = (int16_t)w[3];
+  p.selfHeatStd = (int16_t)w[4];
+  p.selfHeatLp = (int16_t)w[5];
+  p.selfHeatSlopeStd = (int16_t)w[6];
+  p.selfHeatSlopeLp = (int16_t)w[7];
+  return true;
+}
+
+/**
+- CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), bitwise (26 bytes per slot)
+*/
+uint16_t SCD4x_ProfileStore_7Semi::crc16(const uint8_t *p, size_t n) {
+  uint16_t crc = 0xFFFF;
+  while (n--) {
+    crc ^= (uint16_t)(*p++) << 8;
+    for (uint8_t i = 0; i < 8; ++i) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
@@ -0,0 +1,215 @@
+#ifndef _7Semi_SCD4X_PROFILE_H
+#define _7Semi_SCD4X_PROFILE_H
+
+#include <Arduino.h>
+#include "7Semi_SCD4x.h"
+
+/**
+ * 7Semi_SCD4x_Profile.h
+ * ---------------------
+ * Per-serial calibration profiles in EEPROM / flash, restored at boot
+ *
+ * Slot format (28 bytes, little-endian)
+ * -------------------------------------
+ *   [0]       magic 0x5C
+ *   [1]       format version (1)
+ *   [2..7]    sensor serial (48-bit, from readSerialNumber())
+ *   [8]       flags (SCD4X_PROFILE_*: which fields are set)
+ *   [9]       reserved (0)
+ *   [10..11]  temperature offset word (°C = 175 · raw / 65535)
+ *   [12..13]  altitude (m)
+ *   [14..15]  CO₂ gain, Q14 (16384 = 1.0)
+ *   [16..17]  CO₂ offset (ppm, signed)
+ *   [18..19]  self-heating, periodic mode (0.01 °C, + = reads warm)
+ *   [20..21]  self-heating, low-power / single-shot (0.01 °C, + = reads warm)
+ *   [22..23]  self-heating duty slope, periodic (0.01 °C at 100 % duty)
+ *   [24..25]  self-heating duty slope, low-power / single-shot
+ *   [26..27]  CRC-16/CCITT-FALSE over [0, 26)
+ *
+ * Boot restore
+ * ------------
+ * - SCD4x_7Semi::setProfileStore(&store) before begin(); begin() then
+ *   looks up its serial and diff-applies the profile: each on-sensor
+ *   setting (offset, altitude) is read, written only if it differs, and
+ *   persist_settings runs only after a change. A provisioned sensor boots
+ *   with zero NVM writes on either side.
+ * - Software coefficients stay in the store and are applied by the
+ *   sketch: active().correctCo2(ppm) for the CO₂ gain / offset, and
+ *   SCD4x_SelfHeat_7Semi::loadProfile(active()) for self-heating.
+ *
+ * Notes
+ * -----
+ * - Lookup is a scan of `slots` × 28 bytes; an erased (0xFF) or corrupt
+ *   slot is treated as free.
+ * - save() rewrites a slot only if its bytes change.
+ */
+
+#define SCD4X_PROFILE_SLOT_LEN       28
+#define SCD4X_PROFILE_MAGIC          0x5C
+#define SCD4X_PROFILE_VERSION        1
+
+#define SCD4X_PROFILE_TEMP_OFFSET    0x01   // temperature offset word (on-sensor)
+#define SCD4X_PROFILE_ALTITUDE       0x02   // altitude (on-sensor)
+#define SCD4X_PROFILE_CO2_CORR       0x04   // CO₂ gain / offset (software)
+#define SCD4X_PROFILE_SELF_HEAT      0x08   // self-heating offsets (software)
+
+/** - One sensor's calibration */
+struct SCD4x_Profile_7Semi {
+  uint64_t serial = 0;
+  uint8_t  flags = 0;
+  uint16_t tempOffsetRaw = 0;
+  uint16_t altitudeM = 0;
+  uint16_t co2GainQ14 = 16384;
+  int16_t  co2OffsetPpm = 0;
+  // Self-heating: how much too warm the sensor reads (0.01 °C, positive =
+  // reads warm); the software correction subtracts it
+  int16_t  selfHeatStd = 0;   // periodic mode
+  int16_t  selfHeatLp = 0;    // low-power periodic / single-shot
+  int16_t  selfHeatSlopeStd = 0;  // extra heating at 100 % radio duty, periodic
+  int16_t  selfHeatSlopeLp = 0;   // extra heating at 100 % radio duty, low power
+
+  /** - Set the on-sensor temperature offset in °C (rounded to the sensor word) */
+  void setTemperatureOffset(float degC) {
+    tempOffsetRaw = (uint16_t)(degC * 65535.0f / 175.0f + 0.5f);
+    flags |= SCD4X_PROFILE_TEMP_OFFSET;
+  }
+  void setAltitude(uint16_t meters) {
+    altitudeM = meters;
+    flags |= SCD4X_PROFILE_ALTITUDE;
+  }
+  /** - ppm_out = ppm_in · gain_q14 / 16384 + offset */
+  void setCo2Correction(uint16_t gain_q14, int16_t offset_ppm) {
+    co2GainQ14 = gain_q14;
+    co2OffsetPpm = offset_ppm;
+    flags |= SCD4X_PROFILE_CO2_CORR;
+  }
+  /**
+   * - Apply the CO₂ gain / offset to a readMeasurement() value
+   * - return : corrected ppm (rounded, clamped to 0..65535); ppm unchanged
+   *            if the profile has no CO₂ correction
+   */
+  uint16_t correctCo2(uint16_t ppm) const {
+    if (!(flags & SCD4X_PROFILE_CO2_CORR)) return ppm;
+    const int32_t v = (int32_t)(((uint32_t)ppm * co2GainQ14 + 8192UL) >> 14) + co2OffsetPpm;
+    return (uint16_t)(v < 0 ? 0 : (v > 65535 ? 65535 : v));
+  }
+  /** - Self-heating per measurement mode, 0.01 °C (positive = sensor reads warm) */
+  void setSelfHeating(int16_t std_centi, int16_t lp_centi, int16_t slope_std_centi = 0,
+                      int16_t slope_lp_centi = 0) {
+    selfHeatStd = std_centi;
+    selfHeatLp = lp_centi;
+    selfHeatSlopeStd = slope_std_centi;
+    selfHeatSlopeLp = slope_lp_centi;
+    flags |= SCD4X_PROFILE_SELF_HEAT;
+  }
+};
+
+/**
+ * - Byte storage for profiles
+ * - Implement for your medium, or use SCD4x_EepromStorage_7Semi<EEPROMClass>
+ */
+class SCD4x_ProfileStorage_7Semi {
+public:
+  virtual ~SCD4x_ProfileStorage_7Semi() {}
+  /** - Read n bytes at offset; true if all read */
+  virtual bool read(uint32_t offset, uint8_t *buf, size_t n) = 0;
+  /** - Write n bytes at offset; true if all written */
+  virtual bool write(uint32_t offset, const uint8_t *buf, size_t n) = 0;
+  /** - Push data to the medium (flash-emulated EEPROM commit) */
+  virtual bool sync() = 0;
+};
+
+/**
+ * - Adapter for the core's EEPROM object (AVR, ESP32, ESP8266, RP2040 …)
+ * - ESP / RP2040: call EEPROM.begin(size) first; sync() commits
+ */
+template <class EepromT>
+class SCD4x_EepromStorage_7Semi : public SCD4x_ProfileStorage_7Semi {
+public:
+  explicit SCD4x_EepromStorage_7Semi(EepromT &e) : eeprom(e) {}
+  bool read(uint32_t offset, uint8_t *buf, size_t n) override {
+    for (size_t i = 0; i < n; ++i) buf[i] = eeprom.read((int)(offset + i));
+    return true;
+  }
+  bool write(uint32_t offset, const uint8_t *buf, size_t n) override {
+    for (size_t i = 0; i < n; ++i)
+      if (eeprom.read((int)(offset + i)) != buf[i]) eeprom.write((int)(offset + i), buf[i]);
+    return true;
+  }
+  bool sync() override {
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266) || defined(ARDUINO_ARCH_RP2040)
+    return eeprom.commit();
+#else
+    return true;
+#endif
+  }
+
+private:
+  EepromT &eeprom;
+};
+
+class SCD4x_ProfileStore_7Semi {
+public:
+  enum Result : uint8_t { NONE = 0, UNCHANGED, APPLIED, FAILED };
+
+  /**
+   * - storage : byte medium
+   * - base    : first byte of the slot area
+   * - slots   : profiles that fit (slots × 28 bytes reserved)
+   */
+  SCD4x_ProfileStore_7Semi(SCD4x_ProfileStorage_7Semi &storage, uint32_t base = 0, uint8_t slots = 8);
+
+  // ----------------------- Storage ------------------------
+  /** - Load the profile for serial; false if none */
+  bool find(uint64_t serial, SCD4x_Profile_7Semi &out);
+  /** - Store p (same serial → same slot); false if full or write failed */
+  bool save(const SCD4x_Profile_7Semi &p);
+  /** - Remove the profile for serial */
+  bool erase(uint64_t serial);
+  /** - Valid profiles stored */
+  uint8_t count();
+
+  // ---------------------- Boot restore --------------------
+  /**
+   * - Find serial's profile and diff-apply its on-sensor settings
+   * - Sensor must be idle (begin() stops it)
+   * - return : NONE, UNCHANGED (no writes), APPLIED (written + persisted),
+   *            FAILED
+   */
+  uint8_t restore(SCD4x_7Semi &dev, uint64_t serial);
+
+  /** - Profile selected by the last restore() */
+  const SCD4x_Profile_7Semi &active() const { return prof; }
+  bool hasActive() const { return haveProf; }
+  uint8_t lastResult() const { return result; }
+  /** - SCD4X_PROFILE_* bits written to the sensor by the last restore() */
+  uint8_t lastChanged() const { return changed; }
+
+  /** - persist_settings issued by restore() since construction */
+  uint32_t sensorPersists() const { return nPersists; }
+  /** - Bytes written by save() / erase() since construction */
+  uint32_t bytesWritten() const { return nBytes; }
+
+  // ------------------------ Codec -------------------------
+  static void pack(const SCD4x_Profile_7Semi &p, uint8_t *slot);
+  /** - False if the slot is free or corrupt */
+  static bool unpack(const uint8_t *slot, SCD4x_Profile_7Semi &p);
+  static uint16_t crc16(const uint8_t *p, size_t n);
+
+private:
+  SCD4x_ProfileStorage_7Semi *st;
+  uint32_t base;
+  uint8_t slots;
+  SCD4x_Profile_7Semi prof;
+  bool haveProf = false;
+  uint8_t result = NONE;
+  uint8_t changed = 0;
+  uint32_t nPersists = 0;
+  uint32_t nBytes = 0;
+
+  /** - Slot index holding serial (−1 none); free : out first free slot (−1 none) */
+  int16_t locate(uint64_t serial, int16_t &free);
+  bool writeSlot(uint8_t i, const uint8_t *slot);
+};
+
+#endif  // _7Semi_SCD4X_PROFILE_H
@@ -0,0 +1,204 @@
+/**
+ * 7Semi_SCD4x_Psychro.cpp
+ * -----------------------
+ * Table-driven psychrometrics for SCD4x T / RH
+ *
+ * Implementation Notes
+ * --------------------
+ * - ES_TABLE[i] = es(i - 40 °C) in 0.01 Pa, es(T) = 611.2 · exp(17.62·T / (243.12 + T)).
+ * - Partial vapour pressure e = es(T) · RH / 100; dew point = es⁻¹(e).
+ * - Absolute humidity AH = e / (Rv · T_K) = 2.16679 · e[Pa] / T_K  (g/m³).
+ * - Enthalpy h = 1.006·T + x·(2501 + 1.86·T), x = 0.622·e / (p − e).
+ * - Table lives in PROGMEM where supported (AVR); other cores map it to flash/rodata.
+ */
+
+#include "7Semi_SCD4x_Psychro.h"
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_dword
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#endif
+
+// es(T) in 0.01 Pa, T = -40 .. +60 °C, 1 °C steps
+static const uint32_t ES_TABLE[101] PROGMEM = {
+     1902UL,    2109UL,    2336UL,    2586UL,    2858UL,    3157UL,    3484UL,    3840UL,
+     4230UL,    4654UL,    5117UL,    5620UL,    6168UL,    6764UL,    7410UL,    8112UL,
+     8872UL,    9696UL,   10588UL,   11553UL,   12597UL,   13723UL,   14939UL,   16251UL,
+    17665UL,   19187UL,   20826UL,   22589UL,   24483UL,   26518UL,   28703UL,   31047UL,
+    33559UL,   36251UL,   39134UL,   42218UL,   45517UL,   49043UL,   52809UL,   56830UL,
+    61120UL,   65695UL,   70570UL,   75763UL,   81292UL,   87174UL,   93430UL,  100079UL,
+   107143UL,  114643UL,  122603UL,  131046UL,  139998UL,  149483UL,  159531UL,  170167UL,
+   181423UL,  193327UL,  205913UL,  219212UL,  233260UL,  248090UL,  263742UL,  280251UL,
+   297659UL,  316006UL,  335334UL,  355689UL,  377115UL,  399660UL,  423372UL,  448303UL,
+   474505UL,  502031UL,  530939UL,  561284UL,  593128UL,  626531UL,  661558UL,  698274UL,
+   736746UL,  777044UL,  819241UL,  863409UL,  909627UL,  957971UL, 1008523UL, 1061367UL,
+  1116588UL, 1174274UL, 1234516UL, 1297407UL, 1363042UL, 1431521UL, 1502945UL, 1577416UL,
+  1655043UL, 1735933UL, 1820201UL, 1907960UL, 1999329UL,
+};
+
+static const int16_t ES_T_MIN_C = -4000;  // table start, 0.01 °C
+static const uint8_t ES_LAST    = 100;    // last index
+
+// ================= Float API =================
+
+/**
+- Saturation vapour pressure (Pa), clamped to -40..60 °C
+*/
+float SCD4x_Psychro_7Semi::saturationPressure(float tC) {
+  float x = tC + 40.0f;
+  if (x <= 0.0f) return tableAt(0) * 0.01f;
+  if (x >= (float)ES_LAST) return tableAt(ES_LAST) * 0.01f;
+  uint8_t i = (uint8_t)x;
+  float a = (float)tableAt(i);
+  float b = (float)tableAt(i + 1);
+  return (a + (b - a) * (x - (float)i)) * 0.01f;
+}
+
+/**
+- Dew point (°C)
+- tC : temperature in °C
+- rh : relative humidity in %
+*/
+float SCD4x_Psychro_7Semi::dewPoint(float tC, float rh) {
+  if (rh >= 100.0f) return tC;
+  return inverseSaturation(saturationPressure(tC) * rh * 0.01f);
+}
+
+/**
+- Absolute humidity (g/m³)
+*/
+float SCD4x_Psychro_7Semi::absoluteHumidity(float tC, float rh) {
+  float e = saturationPressure(tC) * rh * 0.01f;
+  return 2.16679f * e / (tC + 273.15f);
+}
+
+/**
+- Specific enthalpy (kJ/kg dry air)
+*/
+float SCD4x_Psychro_7Semi::enthalpy(float tC, float rh, float p_pa) {
+  float e = saturationPressure(tC) * rh * 0.01f;
+  float x = 0.622f * e / (p_pa - e);
+  return 1.006f * tC + x * (2501.0f + 1.86f * tC);
+}
+
+// ================= Fixed-point API =================
+
+/**
+- Saturation vapour pressure (0.01 Pa)
+- t_c : temperature in 0.01 °C
+*/
+uint32_t SCD4x_Psychro_7Semi::saturationPressureFixed(int16_t t_c) {
+  int32_t x = (int32_t)t_c - ES_T_MIN_C;
+  if (x <= 0) return tableAt(0);
+  if (x >= (int32_t)ES_LAST * 100) return tableAt(ES_LAST);
+  uint8_t i = (uint8_t)(x / 100);
+  uint32_t frac = (uint32_t)(x % 100);
+  uint32_t a = tableAt(i);
+  uint32_t b = tableAt(i + 1);
+  return a + ((b - a) * frac + 50) / 100;
+}
+
+/**
+- Dew point (0.01 °C)
+- t_c  : temperature in 0.01 °C
+- rh_c : relative humidity in 0.01 %
+*/
+int16_t SCD4x_Psychro_7Semi::dewPointFixed(int16_t t_c, uint16_t rh_c) {
+  if (rh_c >= 10000) return t_c;
+  uint32_t e = (uint32_t)(((uint64_t)saturationPressureFixed(t_c) * rh_c + 5000) / 10000);
+  return inverseSaturationFixed(e);
+}
+
+/**
+- Absolute humidity (0.01 g/m³)
+*/
+uint16_t SCD4x_Psychro_7Semi::absoluteHumidityFixed(int16_t t_c, uint16_t rh_c) {
+  uint64_t e = ((uint64_t)saturationPressureFixed(t_c) * rh_c + 5000) / 10000;  // 0.01 Pa
+  uint32_t tk = (uint32_t)((int32_t)t_c + 27315);                                // 0.01 K
+  // AH[0.01 g/m³] = 216.679 · e[0.01 Pa] / T[0.01 K]
+  return (uint16_t)((e * 216679ULL + (uint64_t)tk * 500) / ((uint64_t)tk * 1000));
+}
+
+/**
+- Specific enthalpy (0.01 kJ/kg dry air)
+- p_pa : total pressure in Pa
+*/
+int32_t SCD4x_Psychro_7Semi::enthalpyFixed(int16_t t_c, uint16_t rh_c, uint32_t p_pa) {
+  uint64_t e = ((uint64_t)saturationPressureFixed(t_c) * rh_c + 5000) / 10000;  // 0.01 Pa
+  uint64_t p = (uint64_t)p_pa * 100;
+  if (e >= p) e = p - 1;
+  // Humidity ratio × 1e6
+  int64_t x = (int64_t)((e * 622000ULL) / (p - e));
+  // 0.01 kJ/kg: 1.006·t_c + x·(250100 + 1.86·t_c) / 1e6
+  int64_t h = ((int64_t)t_c * 1006) / 1000;
+  h += (x * (250100 + ((int64_t)t_c * 186) / 100) + 500000) / 1000000;
+  return (int32_t)h;
+}
+
+// ================= Reference (libm) =================
+
+/**
+- Dew point via Magnus with logf/expf (reference)
+*/
+float SCD4x_Psychro_7Semi::dewPointReference(float tC, float rh) {
+  float g = logf(rh * 0.01f) + 17.62f * tC / (243.12f + tC);
+  return 243.12f * g / (17.62f - g);
+}
+
+/**
+- Absolute humidity via expf (reference)
+*/
+float SCD4x_Psychro_7Semi::absoluteHumidityReference(float tC, float rh) {
+  float es = 611.2f * expf(17.62f * tC / (243.12f + tC));
+  return 2.16679f * es * rh * 0.01f / (tC + 273.15f);
+}
+
+// ================= Helpers =================
+
+/**
+- Read ES_TABLE[i] from flash
+*/
+uint32_t SCD4x_Psychro_7Semi::tableAt(uint8_t i) {
+  return pgm_read_dword(&ES_TABLE[i]);
+}
+
+/**
+- Find table segment holding e (0.01 Pa); returns lower index
+*/
+static uint8_t findSegment(uint32_t e_cpa) {
+  uint8_t lo = 0, hi = ES_LAST;
+  while (hi - lo > 1) {
+    uint8_t mid = (uint8_t)((lo + hi) >> 1);
+    if (pgm_read_dword(&ES_TABLE[mid]) <= e_cpa) lo = mid;
+    else hi = mid;
+  }
+  return lo;
+}
+
+/**
+- Invert es table (0.01 Pa → 0.01 °C), clamped to -40..60 °C
+*/
+int16_t SCD4x_Psychro_7Semi::inverseSaturationFixed(uint32_t e_cpa) {
+  if (e_cpa <= tableAt(0)) return ES_T_MIN_C;
+  if (e_cpa >= tableAt(ES_LAST)) return ES_T_MIN_C + (int16_t)ES_LAST * 100;
+  uint8_t i = findSegment(e_cpa);
+  uint32_t a = tableAt(i);
+  uint32_t b = tableAt(i + 1);
+  uint32_t frac = ((e_cpa - a) * 100 + (b - a) / 2) / (b - a);
+  return (int16_t)(ES_T_MIN_C + (int16_t)i * 100 + (int16_t)frac);
+}
+
+/**
+- Invert es table (Pa → °C), clamped to -40..60 °C
+*/
+float SCD4x_Psychro_7Semi::inverseSaturation(float e_pa) {
+  float e = e_pa * 100.0f;
+  if (e <= (float)tableAt(0)) return -40.0f;
+  if (e >= (float)tableAt(ES_LAST)) return 60.0f;
+  uint8_t i = findSegment((uint32_t)e);
+  float a = (float)tableAt(i);
+  float b = (float)tableAt(i + 1);
+  return (float)i - 40.0f + (e - a) / (b - a);
+}
@@ -0,0 +1,74 @@
+#ifndef _7Semi_SCD4X_PSYCHRO_H
+#define _7Semi_SCD4X_PSYCHRO_H
+
+#include <Arduino.h>
+
+/**
+ * 7Semi_SCD4x_Psychro.h
+ * ---------------------
+ * Fast psychrometric metrics derived from SCD4x T / RH (no logf/expf)
+ *
+ * Metrics
+ * -------
+ * - Dew point (°C)
+ * - Absolute humidity (g/m³)
+ * - Specific enthalpy of moist air (kJ/kg dry air)
+ *
+ * Method
+ * ------
+ * - Saturation vapour pressure es(T) (Magnus, 17.62 / 243.12 °C, over water)
+ *   is tabulated at 1 °C steps from -40 °C to +60 °C (101 × uint32, flash).
+ * - es(T) uses linear interpolation; dew point inverts the same table
+ *   (binary search + interpolation), so no log/exp is evaluated.
+ * - Float API  : °C, %RH           (drop-in for readMeasurement() outputs)
+ * - Fixed API  : centi-°C, centi-%RH (integer only, suited to FPU-less MCUs)
+ *
+ * Accuracy vs libm Magnus, T = -10..60 °C, RH = 1..100 %
+ * ------------------------------------------------------
+ * - Dew point          : |err| ≤ 0.012 °C float, ≤ 0.018 °C fixed (clamped at -40 °C)
+ * - Absolute humidity  : |err| ≤ 0.07 % relative float, ≤ 0.04 g/m³ fixed
+ * - Enthalpy           : |err| ≤ 0.12 kJ/kg (float and fixed)
+ * - Magnus itself is within ±0.35 °C of the exact dew point over this range.
+ */
+
+class SCD4x_Psychro_7Semi {
+public:
+  // ---------------------- Float API ----------------------
+  /** - Saturation vapour pressure in Pa at tC (°C) */
+  static float saturationPressure(float tC);
+  /** - Dew point in °C from tC (°C) and rh (%) */
+  static float dewPoint(float tC, float rh);
+  /** - Absolute humidity in g/m³ */
+  static float absoluteHumidity(float tC, float rh);
+  /**
+   * - Specific enthalpy in kJ/kg dry air
+   * - p_pa : total pressure in Pa (default sea level)
+   */
+  static float enthalpy(float tC, float rh, float p_pa = 101325.0f);
+
+  // ------------------ Fixed-point API --------------------
+  /** - Saturation vapour pressure in 0.01 Pa at t_c (0.01 °C) */
+  static uint32_t saturationPressureFixed(int16_t t_c);
+  /** - Dew point in 0.01 °C from t_c (0.01 °C) and rh_c (0.01 %RH) */
+  static int16_t dewPointFixed(int16_t t_c, uint16_t rh_c);
+  /** - Absolute humidity in 0.01 g/m³ */
+  static uint16_t absoluteHumidityFixed(int16_t t_c, uint16_t rh_c);
+  /** - Specific enthalpy in 0.01 kJ/kg dry air; p_pa : total pressure in Pa */
+  static int32_t enthalpyFixed(int16_t t_c, uint16_t rh_c, uint32_t p_pa = 101325UL);
+
+  // ------------------ Reference (libm) -------------------
+  /** - Dew point using logf/expf (for validation / benchmarking) */
+  static float dewPointReference(float tC, float rh);
+  /** - Absolute humidity using expf (for validation / benchmarking) */
+  static float absoluteHumidityReference(float tC, float rh);
+
+private:
+  /** - Inverse of the es table: 0.01 Pa → 0.01 °C (clamped to table range) */
+  static int16_t inverseSaturationFixed(uint32_t e_cpa);
+  /** - Inverse of the es table in float: Pa → °C */
+  static float inverseSaturation(float e_pa);
+  /** - Read one table entry (0.01 Pa) */
+  static uint32_t tableAt(uint8_t i);
+};
+
+#endif  // _7Semi_SCD4X_PSYCHRO_H
@@ -0,0 +1,301 @@
+/**
+ * 7Semi_SCD4x_Queue.cpp
+ * ---------------------
+ * Priority / deadline command queue around the periodic sample reads
+ *
+ * Implementation Notes
+ * --------------------
+ * - The queue is a small fixed array; selection is a linear scan (depth is
+ *   single digits), so enqueue is O(1) and dispatch O(depth).
+ * - busyUntilMs holds the sensor's execution time after each command
+ *   (persistSettings 800 ms, stop 500 ms, reinit 30 ms); the driver only
+ *   waits for its own read delays, so update() returns right away.
+ * - The expected ready time is re-based on every read to read time +
+ *   period − one poll interval, so a drifting sensor clock costs at most
+ *   one extra data-ready poll per sample.
+ * - Execution times and idle-only flags follow the SCD4x datasheet command
+ *   table; only the ambient pressure commands are accepted while measuring.
+ * - millis() wraps every ~49 days; all comparisons use signed differences.
+ */
+
+#include "7Semi_SCD4x_Queue.h"
+
+#define SCD4X_QUEUE_POLL_MS  20   // data-ready retry interval
+#define SCD4X_QUEUE_STOP_MS  500  // stop_periodic_measurement execution time
+
+// ================= Setup =================
+
+SCD4x_Queue_7Semi::SCD4x_Queue_7Semi(SCD4x_7Semi &sensor) : dev(&sensor) {
+  memset(q, 0, sizeof(q));
+  memset(&st, 0, sizeof(st));
+}
+
+void SCD4x_Queue_7Semi::onSample(SCD4x_QueueSample_7Semi cb) { sampleCb = cb; }
+
+void SCD4x_Queue_7Semi::onDone(SCD4x_QueueDone_7Semi cb) { doneCb = cb; }
+
+void SCD4x_Queue_7Semi::setGuard(uint16_t ms) { guardMs = ms; }
+
+void SCD4x_Queue_7Semi::setAllowStop(bool allow) { allowStop = allow; }
+
+void SCD4x_Queue_7Semi::resetStats() {
+  const uint8_t d = st.depth;
+  memset(&st, 0, sizeof(st));
+  st.depth = d;
+  st.maxDepth = d;
+}
+
+// ================= Measurement =================
+
+/**
+- Start measuring; first sample expected one period from now
+*/
+bool SCD4x_Queue_7Semi::startPeriodic(bool low_power) {
+  lowPower = low_power;
+  const bool ok = low_power ? dev->startLowPowerPeriodicMeasurement() : dev->startPeriodicMeasurement();
+  if (!ok) return false;
+  const uint32_t now = millis();
+  state = RUN;
+  freshSample = false;
+  nextReadyMs = now + periodMs();
+  nextPollMs = nextReadyMs;
+  return true;
+}
+
+bool SCD4x_Queue_7Semi::stopPeriodic() {
+  if (!dev->stopPeriodicMeasurement()) return false;
+  state = IDLE;
+  busyUntilMs = millis() + SCD4X_QUEUE_STOP_MS;
+  return true;
+}
+
+// ================= Queue =================
+
+bool SCD4x_Queue_7Semi::enqueue(Op op, uint8_t priority, uint32_t deadline_ms, uint16_t arg, uint16_t tag) {
+  if (op >= OP_COUNT) return false;
+  for (uint8_t i = 0; i < SCD4X_QUEUE_DEPTH; ++i) {
+    Entry &e = q[i];
+    if (e.used) continue;
+    e.op = op;
+    e.priority = priority;
+    e.used = true;
+    e.deferred = false;
+    e.arg = arg;
+    e.tag = tag;
+    e.deadlineMs = deadline_ms;
+    e.enqueuedMs = millis();
+    e.seq = seq++;
+    if (++st.depth > st.maxDepth) st.maxDepth = st.depth;
+    return true;
+  }
+  ++st.dropped;
+  return false;
+}
+
+// ================= Dispatch =================
+
+/**
+- One step: sample first, then a bracket, then the best op that fits
+*/
+bool SCD4x_Queue_7Semi::update() {
+  const uint32_t now = millis();
+  if ((int32_t)(now - busyUntilMs) < 0) return false;
+
+  if (state == RUN) {
+    // From the expected ready time on the bus belongs to the sample
+    if ((int32_t)(now - nextReadyMs) >= 0) {
+      if ((int32_t)(now - nextPollMs) < 0) return false;
+      return readSample(now);
+    }
+    // Idle-only work: one bracket right after a read, or earlier when an
+    // idle-only deadline would pass before the next sample
+    const bool fresh = freshSample;
+    freshSample = false;
+    if (allowStop && idleWork(fresh ? 0 : nextReadyMs)) {
+      if (!dev->stopPeriodicMeasurement()) {
+        ++st.failed;
+        return true;
+      }
+      state = BRACKET;
+      busyUntilMs = now + SCD4X_QUEUE_STOP_MS;
+      ++st.brackets;
+      return true;
+    }
+    const int8_t i = best(false, now);
+    if (i < 0) return false;
+    run(i, now);
+    return true;
+  }
+
+  const int8_t i = best(true, now);
+  if (i >= 0) {
+    run(i, now);
+    return true;
+  }
+  if (state == BRACKET) return restart(now);
+  return false;
+}
+
+/**
+- Ordering: priority desc, deadline asc (0 = none), enqueue asc
+*/
+bool SCD4x_Queue_7Semi::before(const Entry &a, const Entry &b) const {
+  if (a.priority != b.priority) return a.priority > b.priority;
+  if (a.deadlineMs != b.deadlineMs) {
+    if (!a.deadlineMs) return false;
+    if (!b.deadlineMs) return true;
+    return (int32_t)(a.deadlineMs - b.deadlineMs) < 0;
+  }
+  return (int32_t)(a.seq - b.seq) < 0;
+}
+
+/**
+- Best runnable entry; while measuring only ops that finish before the
+  next sample (minus guard) are runnable
+- return : index, or -1
+*/
+int8_t SCD4x_Queue_7Semi::best(bool idle_ops, uint32_t now) {
+  int8_t b = -1;
+  for (uint8_t i = 0; i < SCD4X_QUEUE_DEPTH; ++i) {
+    Entry &e = q[i];
+    if (!e.used) continue;
+    if (!idle_ops) {
+      if (idleOnly(e.op)) continue;
+      if ((int32_t)(nextReadyMs - (now + execMs(e.op) + guardMs)) < 0) {
+        if (!e.deferred) {
+          e.deferred = true;
+          ++st.deferred;
+        }
+        continue;
+      }
+    }
+    if (b < 0 || before(e, q[b])) b = (int8_t)i;
+  }
+  return b;
+}
+
+/**
+- Any idle-only op queued; with by_ms != 0 only ops whose deadline is
+  before by_ms count
+*/
+bool SCD4x_Queue_7Semi::idleWork(uint32_t by_ms) const {
+  for (uint8_t i = 0; i < SCD4X_QUEUE_DEPTH; ++i) {
+    const Entry &e = q[i];
+    if (!e.used || !idleOnly(e.op)) continue;
+    if (!by_ms || (e.deadlineMs && (int32_t)(e.deadlineMs - by_ms) < 0)) return true;
+  }
+  return false;
+}
+
+/**
+- Poll data-ready; read and deliver the sample once it is there
+*/
+bool SCD4x_Queue_7Semi::readSample(uint32_t now) {
+  uint16_t status = 0;
+  if (!dev->getDataReadyStatus(status)) {
+    ++st.sampleErrors;
+    nextPollMs = now + SCD4X_QUEUE_POLL_MS;
+    return true;
+  }
+  if ((status & 0x07FF) == 0) {
+    nextPollMs = now + SCD4X_QUEUE_POLL_MS;
+    return true;
+  }
+
+  SCD4x_RawSample_7Semi s;
+  if (!dev->readMeasurementRaw(s.co2_raw, s.t_raw, s.rh_raw)) {
+    ++st.sampleErrors;
+    nextPollMs = now + SCD4X_QUEUE_POLL_MS;
+    return true;
+  }
+  s.t_ms = millis();
+
+  const uint32_t lag = now - nextReadyMs;
+  if (lag > st.maxSampleLagMs) st.maxSampleLagMs = lag;
+  if (lag > guardMs) ++st.lateSamples;
+  ++st.samples;
+
+  nextReadyMs = now + periodMs() - SCD4X_QUEUE_POLL_MS;
+  nextPollMs = nextReadyMs;
+  freshSample = true;
+  if (sampleCb) sampleCb(s);
+  return true;
+}
+
+/**
+- Execute one entry and report it; the slot is free before the callback
+*/
+void SCD4x_Queue_7Semi::run(int8_t i, uint32_t now) {
+  Entry &e = q[i];
+  SCD4x_QueueResult_7Semi r;
+  r.op = e.op;
+  r.tag = e.tag;
+  r.value = 0;
+  r.waitMs = now - e.enqueuedMs;
+
+  bool b = false;
+  switch (e.op) {
+    case PERSIST_SETTINGS:        r.ok = dev->persistSettings(); break;
+    case GET_ASC_ENABLED:         r.ok = dev->getAutomaticSelfCalibrationEnabled(b); r.value = b; break;
+    case SET_ASC_ENABLED:         r.ok = dev->setAutomaticSelfCalibrationEnabled(e.arg != 0); break;
+    case GET_ASC_TARGET:          r.ok = dev->getAutomaticSelfCalibrationTarget(r.value); break;
+    case SET_ASC_TARGET:          r.ok = dev->setAutomaticSelfCalibrationTarget(e.arg); break;
+    case GET_ASC_INITIAL_PERIOD:  r.ok = dev->getAutomaticSelfCalibrationInitialPeriod(r.value); break;
+    case SET_ASC_INITIAL_PERIOD:  r.ok = dev->setAutomaticSelfCalibrationInitialPeriod(e.arg); break;
+    case GET_ASC_STANDARD_PERIOD: r.ok = dev->getAutomaticSelfCalibrationStandardPeriod(r.value); break;
+    case SET_ASC_STANDARD_PERIOD: r.ok = dev->setAutomaticSelfCalibrationStandardPeriod(e.arg); break;
+    case GET_SENSOR_VARIANT:      r.ok = dev->getSensorVariantRaw(r.value); break;
+    case GET_TEMPERATURE_OFFSET:  r.ok = dev->getTemperatureOffsetRaw(r.value); break;
+    case SET_TEMPERATURE_OFFSET:  r.ok = dev->setTemperatureOffsetRaw(e.arg); break;
+    case GET_SENSOR_ALTITUDE:     r.ok = dev->getSensorAltitude(r.value); break;
+    case SET_SENSOR_ALTITUDE:     r.ok = dev->setSensorAltitude(e.arg); break;
+    case GET_AMBIENT_PRESSURE:    r.ok = dev->getAmbientPressureRaw(r.value); break;
+    case SET_AMBIENT_PRESSURE:    r.ok = dev->setAmbientPressureRaw(e.arg); break;
+    case REINIT:                  r.ok = dev->reInit(); break;
+    default:                      r.ok = false; break;
+  }
+
+  const uint32_t done = millis();
+  busyUntilMs = done + execMs(e.op);
+  r.late = e.deadlineMs && (int32_t)(done - e.deadlineMs) > 0;
+
+  e.used = false;
+  --st.depth;
+  ++st.dispatched;
+  if (!r.ok) ++st.failed;
+  if (r.late) ++st.deadlineMisses;
+  if (doneCb) doneCb(r);
+}
+
+/**
+- Close a bracket: restart measuring in the previous mode
+*/
+bool SCD4x_Queue_7Semi::restart(uint32_t now) {
+  const bool ok = lowPower ? dev->startLowPowerPeriodicMeasurement() : dev->startPeriodicMeasurement();
+  if (!ok) {
+    ++st.failed;
+    busyUntilMs = now + SCD4X_QUEUE_POLL_MS;
+    return true;
+  }
+  // Shift: new expected sample vs. the one the bracket discarded
+  const int32_t shift = (int32_t)(now + periodMs() - nextReadyMs);
+  if (shift > 0) st.shiftMs += (uint32_t)shift;
+  state = RUN;
+  nextReadyMs = now + periodMs();
+  nextPollMs = nextReadyMs;
+  return true;
+}
+
+// ================= Command table =================
+
+bool SCD4x_Queue_7Semi::idleOnly(uint8_t op) {
+  return op != GET_AMBIENT_PRESSURE && op != SET_AMBIENT_PRESSURE;
+}
+
+uint16_t SCD4x_Queue_7Semi::execMs(uint8_t op) {
+  switch (op) {
+    case PERSIST_SETTINGS: return 800;
+    case REINIT:           return 30;
+    default:               return 1;
+  }
+}
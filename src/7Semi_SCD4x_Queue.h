@@ -0,0 +1,188 @@
+#ifndef _7Semi_SCD4X_QUEUE_H
+#define _7Semi_SCD4X_QUEUE_H
+
+#include <Arduino.h>
+#include "7Semi_SCD4x.h"
+#include "7Semi_SCD4x_Sample.h"
+
+/**
+ * 7Semi_SCD4x_Queue.h
+ * -------------------
+ * Per-sensor command queue: maintenance operations (persistSettings(), ASC
+ * getters, variant, compensation) ordered by priority and deadline, fitted
+ * around the periodic sample reads
+ *
+ * Dispatch rules
+ * --------------
+ * - Sample reads are implicit and always first: from the expected ready
+ *   time on, update() only polls data-ready and reads the sample.
+ * - A queued op runs only if its execution time ends at least guardMs
+ *   before the next expected sample; otherwise it is deferred (counted).
+ * - Order among runnable ops: higher priority, then earlier deadline
+ *   (0 = none), then enqueue order.
+ * - Most commands are only accepted while the sensor is idle. In periodic
+ *   mode those ops are batched into one stop → ops → restart bracket,
+ *   started right after a sample read (or earlier if an idle-only
+ *   deadline falls before the next sample). The stop discards the
+ *   measurement in progress: right after a read that only delays the next
+ *   sample by the bracket's length; a bracket started early for a deadline
+ *   also throws away the part of the period already measured, so the
+ *   sample that was due is never read. Both re-base the cadence (shiftMs).
+ *   setAllowStop(false) keeps them queued until the caller stops measuring.
+ *
+ * Usage
+ * -----
+ * - q.startPeriodic(); then call q.update() every loop() iteration.
+ * - q.enqueue(SCD4x_Queue_7Semi::PERSIST_SETTINGS, 1, millis() + 60000);
+ * - Results arrive through onDone(), samples through onSample().
+ *
+ * Notes
+ * -----
+ * - Fixed capacity (SCD4X_QUEUE_DEPTH), no heap; update() never waits for
+ *   an execution time, only for the driver's own short transfer delays.
+ * - Drive the sensor only through the queue while it is attached.
+ */
+
+#ifndef SCD4X_QUEUE_DEPTH
+#define SCD4X_QUEUE_DEPTH 8
+#endif
+
+/** - Outcome of one queued op */
+struct SCD4x_QueueResult_7Semi {
+  uint8_t  op;       // SCD4x_Queue_7Semi::Op
+  uint16_t tag;      // caller tag from enqueue()
+  bool     ok;
+  bool     late;     // completed after its deadline
+  uint16_t value;    // getters: result (temperature offset as the sensor word, ASC enabled 0/1)
+  uint32_t waitMs;   // enqueue → dispatch
+};
+
+/** - Queue and dispatch counters */
+struct SCD4x_QueueStats_7Semi {
+  uint8_t  depth;           // ops queued now
+  uint8_t  maxDepth;        // deepest queue seen
+  uint32_t dispatched;      // ops executed
+  uint32_t failed;          // ops whose driver call failed
+  uint32_t dropped;         // enqueue() rejected: queue full
+  uint32_t deadlineMisses;  // ops completed after their deadline
+  uint32_t deferred;        // ops held back to protect a sample read (once per op)
+  uint32_t samples;         // samples read
+  uint32_t sampleErrors;    // data-ready / read failures
+  uint32_t lateSamples;     // read more than guardMs after expected ready
+  uint32_t maxSampleLagMs;  // worst expected-ready → read
+  uint32_t brackets;        // stop → ops → restart cycles
+  uint32_t shiftMs;         // total cadence shift caused by brackets
+};
+
+/** - Sample callback (raw words, t_ms = read time) */
+typedef void (*SCD4x_QueueSample_7Semi)(const SCD4x_RawSample_7Semi &sample);
+/** - Op completion callback */
+typedef void (*SCD4x_QueueDone_7Semi)(const SCD4x_QueueResult_7Semi &result);
+
+class SCD4x_Queue_7Semi {
+public:
+  enum Op : uint8_t {
+    PERSIST_SETTINGS = 0,
+    GET_ASC_ENABLED,
+    SET_ASC_ENABLED,
+    GET_ASC_TARGET,
+    SET_ASC_TARGET,
+    GET_ASC_INITIAL_PERIOD,
+    SET_ASC_INITIAL_PERIOD,
+    GET_ASC_STANDARD_PERIOD,
+    SET_ASC_STANDARD_PERIOD,
+    GET_SENSOR_VARIANT,
+    GET_TEMPERATURE_OFFSET,
+    SET_TEMPERATURE_OFFSET,   // arg : sensor word (°C = 175 · raw / 65535)
+    GET_SENSOR_ALTITUDE,
+    SET_SENSOR_ALTITUDE,
+    GET_AMBIENT_PRESSURE,
+    SET_AMBIENT_PRESSURE,     // allowed while measuring
+    REINIT,
+    OP_COUNT
+  };
+
+  /** - Bind to a begun driver */
+  explicit SCD4x_Queue_7Semi(SCD4x_7Semi &sensor);
+
+  // -------------------- Configuration --------------------
+  void onSample(SCD4x_QueueSample_7Semi cb);
+  void onDone(SCD4x_QueueDone_7Semi cb);
+  /** - Margin kept free before an expected sample, and read slack (ms, default 50) */
+  void setGuard(uint16_t ms);
+  /** - Allow stop / restart brackets for idle-only ops (default true) */
+  void setAllowStop(bool allow);
+
+  // ---------------------- Measurement ---------------------
+  /** - Start periodic (5 s) or low-power periodic (30 s) measurement */
+  bool startPeriodic(bool low_power = false);
+  /** - Stop measurement; queued idle-only ops then run directly */
+  bool stopPeriodic();
+
+  // ------------------------ Queue -------------------------
+  /**
+   * - Queue one op
+   * - priority    : higher runs first
+   * - deadline_ms : absolute millis() (0 = none); a miss is counted, the
+   *                 op still runs
+   * - arg         : setter value; tag : echoed in the result
+   * - return      : false if the queue is full or op is unknown
+   */
+  bool enqueue(Op op, uint8_t priority = 0, uint32_t deadline_ms = 0, uint16_t arg = 0, uint16_t tag = 0);
+
+  /**
+   * - One dispatch step (never waits out an execution time)
+   * - return : true if the bus was used
+   */
+  bool update();
+
+  uint8_t depth() const { return st.depth; }
+  bool measuring() const { return state != IDLE; }
+  /** - millis() at which the next sample is expected (0 when idle) */
+  uint32_t nextSampleMs() const { return state == IDLE ? 0 : nextReadyMs; }
+  const SCD4x_QueueStats_7Semi &stats() const { return st; }
+  void resetStats();
+
+private:
+  enum State : uint8_t { IDLE = 0, RUN, BRACKET };
+
+  struct Entry {
+    uint8_t  op;
+    uint8_t  priority;
+    bool     used;
+    bool     deferred;
+    uint16_t arg;
+    uint16_t tag;
+    uint32_t deadlineMs;
+    uint32_t enqueuedMs;
+    uint32_t seq;
+  };
+
+  SCD4x_7Semi *dev;
+  SCD4x_QueueSample_7Semi sampleCb = nullptr;
+  SCD4x_QueueDone_7Semi doneCb = nullptr;
+  Entry q[SCD4X_QUEUE_DEPTH];
+  uint32_t seq = 0;
+  SCD4x_QueueStats_7Semi st;
+
+  uint8_t  state = IDLE;
+  bool     lowPower = false;
+  bool     allowStop = true;
+  bool     freshSample = false;  // a sample was read on the previous update()
+  uint16_t guardMs = 50;
+  uint32_t busyUntilMs = 0;
+  uint32_t nextReadyMs = 0;
+  uint32_t nextPollMs = 0;
+
+  uint32_t periodMs() const { return lowPower ? 30000UL : 5000UL; }
+  static bool idleOnly(uint8_t op);
+  static uint16_t execMs(uint8_t op);
+  bool before(const Entry &a, const Entry &b) const;
+  int8_t best(bool idle_ops, uint32_t now);
+  bool idleWork(uint32_t by_ms) const;
+  bool readSample(uint32_t now);
+  void run(int8_t i, uint32_t now);
+  bool restart(uint32_t now);
+};
+
+#endif  // _7Semi_SCD4X_QUEUE_H
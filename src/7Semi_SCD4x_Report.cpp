@@ -0,0 +1,94 @@
+/**
+ * 7Semi_SCD4x_Report.cpp
+ * ----------------------
+ * Dead-band + heartbeat uplink filter
+ *
+ * Implementation Notes
+ * --------------------
+ * - Comparison is against the last reported sample (not the last offered one),
+ *   so slow drifts still trigger a report once they exceed the dead-band.
+ * - Heartbeat uses unsigned millis() arithmetic (rollover-safe).
+ */
+
+#include "7Semi_SCD4x_Report.h"
+
+/**
+- Construct filter with dead-bands and heartbeat
+*/
+SCD4x_Report_7Semi::SCD4x_Report_7Semi(uint16_t co2_band, uint16_t temp_band_c,
+                                       uint16_t rh_band_c, uint32_t heartbeat_ms)
+  : bandCo2(co2_band), bandT(temp_band_c), bandRh(rh_band_c), heartbeat(heartbeat_ms) {}
+
+void SCD4x_Report_7Semi::setDeadBands(uint16_t co2_band, uint16_t temp_band_c, uint16_t rh_band_c) {
+  bandCo2 = co2_band;
+  bandT = temp_band_c;
+  bandRh = rh_band_c;
+}
+
+void SCD4x_Report_7Semi::setHeartbeat(uint32_t heartbeat_ms) { heartbeat = heartbeat_ms; }
+
+/**
+- Offer a float sample (converted to integer units)
+*/
+bool SCD4x_Report_7Semi::offer(uint16_t co2_ppm, float temp_c, float rh_percent, uint32_t now_ms) {
+  int16_t t = (int16_t)(temp_c * 100.0f + (temp_c >= 0.0f ? 0.5f : -0.5f));
+  uint16_t rh = (uint16_t)(rh_percent * 100.0f + 0.5f);
+  return offerFixed(co2_ppm, t, rh, now_ms);
+}
+
+/**
+- Offer an integer sample
+- return : true → transmit; state updated to this sample
+*/
+bool SCD4x_Report_7Semi::offerFixed(uint16_t co2_ppm, int16_t temp_c, uint16_t rh_c, uint32_t now_ms) {
+  ++nOffered;
+
+  uint8_t why = NONE;
+  if (!primed) {
+    why = FIRST;
+  } else {
+    if (exceeds(co2_ppm, lastCo2, bandCo2)) why |= CO2;
+    if (exceeds(temp_c, lastT, bandT))      why |= TEMP;
+    if (exceeds(rh_c, lastRh, bandRh))      why |= HUMIDITY;
+    if (heartbeat && (now_ms - lastMs) >= heartbeat) why |= HEARTBEAT;
+  }
+
+  lastReason = why;
+  if (why == NONE) return false;
+
+  primed = true;
+  lastCo2 = co2_ppm;
+  lastT = temp_c;
+  lastRh = rh_c;
+  lastMs = now_ms;
+  ++nReported;
+  return true;
+}
+
+uint8_t SCD4x_Report_7Semi::reason() const { return lastReason; }
+
+void SCD4x_Report_7Semi::invalidate() { primed = false; }
+
+// ================= Stats =================
+
+uint32_t SCD4x_Report_7Semi::offered() const { return nOffered; }
+
+uint32_t SCD4x_Report_7Semi::reported() const { return nReported; }
+
+uint16_t SCD4x_Report_7Semi::suppressionPermille() const {
+  if (nOffered == 0) return 0;
+  return (uint16_t)((uint64_t)(nOffered - nReported) * 1000 / nOffered);
+}
+
+void SCD4x_Report_7Semi::resetStats() {
+  nOffered = 0;
+  nReported = 0;
+}
+
+// ================= Helpers =================
+
+bool SCD4x_Report_7Semi::exceeds(int32_t a, int32_t b, uint16_t band) {
+  int32_t d = a - b;
+  if (d < 0) d = -d;
+  return d > (int32_t)band;
+}
@@ -0,0 +1,96 @@
+#ifndef _7Semi_SCD4X_REPORT_H
+#define _7Semi_SCD4X_REPORT_H
+
+#include <Arduino.h>
+
+/**
+ * 7Semi_SCD4x_Report.h
+ * --------------------
+ * Dead-band / heartbeat report filter for SCD4x uplinks (LoRa, cellular, …)
+ *
+ * Rule
+ * ----
+ * - A sample is reported when any channel moved more than its dead-band
+ *   since the last *reported* sample, or when the heartbeat interval expired.
+ * - Otherwise it is suppressed.
+ *
+ * Notes
+ * -----
+ * - State per channel: last reported value (2 bytes) + dead-band (2 bytes).
+ * - Units: CO₂ ppm, T 0.01 °C, RH 0.01 %RH.
+ * - Dead-band 0 on a channel reports every change of that channel.
+ */
+
+class SCD4x_Report_7Semi {
+public:
+  // Bits returned by reason()
+  enum Reason : uint8_t {
+    NONE      = 0x00,
+    FIRST     = 0x01,
+    CO2       = 0x02,
+    TEMP      = 0x04,
+    HUMIDITY  = 0x08,
+    HEARTBEAT = 0x10
+  };
+
+  /**
+   * - Construct filter
+   * - co2_band    : CO₂ dead-band in ppm
+   * - temp_band_c : temperature dead-band in 0.01 °C
+   * - rh_band_c   : humidity dead-band in 0.01 %RH
+   * - heartbeat_ms: max time between reports (0 = disabled)
+   */
+  SCD4x_Report_7Semi(uint16_t co2_band = 25, uint16_t temp_band_c = 20,
+                     uint16_t rh_band_c = 100, uint32_t heartbeat_ms = 900000UL);
+
+  /** - Set dead-bands (ppm, 0.01 °C, 0.01 %RH) */
+  void setDeadBands(uint16_t co2_band, uint16_t temp_band_c, uint16_t rh_band_c);
+  /** - Set heartbeat interval in ms (0 = disabled) */
+  void setHeartbeat(uint32_t heartbeat_ms);
+
+  /**
+   * - Offer one sample
+   * - co2_ppm, temp_c, rh_percent : as returned by readMeasurement()
+   * - now_ms : millis()
+   * - return : true if the sample should be transmitted
+   */
+  bool offer(uint16_t co2_ppm, float temp_c, float rh_percent, uint32_t now_ms);
+  /** - Same, with integer inputs (ppm, 0.01 °C, 0.01 %RH) */
+  bool offerFixed(uint16_t co2_ppm, int16_t temp_c, uint16_t rh_c, uint32_t now_ms);
+
+  /** - Why the last offered sample was reported (Reason bits, NONE if suppressed) */
+  uint8_t reason() const;
+  /** - Force the next offer() to report (e.g. after a failed uplink) */
+  void invalidate();
+
+  // ----------------------- Stats -------------------------
+  /** - Samples offered since resetStats() */
+  uint32_t offered() const;
+  /** - Samples reported since resetStats() */
+  uint32_t reported() const;
+  /** - Suppressed / offered in ‰ (0..1000) */
+  uint16_t suppressionPermille() const;
+  /** - Clear counters */
+  void resetStats();
+
+private:
+  uint16_t bandCo2;
+  uint16_t bandT;
+  uint16_t bandRh;
+  uint32_t heartbeat;
+
+  bool     primed = false;
+  uint8_t  lastReason = NONE;
+  uint16_t lastCo2 = 0;
+  int16_t  lastT = 0;
+  uint16_t lastRh = 0;
+  uint32_t lastMs = 0;
+
+  uint32_t nOffered = 0;
+  uint32_t nReported = 0;
+
+  /** - |a - b| > band */
+  static bool exceeds(int32_t a, int32_t b, uint16_t band);
+};
+
+#endif  // _7Semi_SCD4X_REPORT_H
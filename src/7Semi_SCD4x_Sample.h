@@ -0,0 +1,49 @@
+#ifndef _7Semi_SCD4X_SAMPLE_H
+#define _7Semi_SCD4X_SAMPLE_H
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
+
+/**
+ * 7Semi_SCD4x_Sample.h
+ * --------------------
+ * Timestamped raw SCD4x sample shared by the codecs, log and host tools
+ *
+ * Notes
+ * -----
+ * - Raw words are exactly what readMeasurementRaw() returns (CRC stripped).
+ * - Conversions match readMeasurement():
+ *     T(°C)  = -45 + 175 * t_raw / 65535
+ *     RH(%)  = 100 * rh_raw / 65535
+ *     CO₂ppm = co2_raw
+ * - Integer conversions round to nearest 0.01 unit.
+ * - Header-only and Arduino-independent, so host tools share the same layout.
+ */
+
+struct SCD4x_RawSample_7Semi {
+  uint32_t t_ms;      // capture time (millis() or host clock)
+  uint16_t co2_raw;
+  uint16_t t_raw;
+  uint16_t rh_raw;
+
+  /** - CO₂ in ppm */
+  uint16_t co2Ppm() const { return co2_raw; }
+  /** - Temperature in 0.01 °C */
+  int16_t tempCentiC() const {
+    return (int16_t)(-4500 + (int32_t)(((uint32_t)t_raw * 17500UL + 32767UL) / 65535UL));
+  }
+  /** - Relative humidity in 0.01 %RH */
+  uint16_t rhCenti() const {
+    return (uint16_t)(((uint32_t)rh_raw * 10000UL + 32767UL) / 65535UL);
+  }
+  /** - Temperature in °C */
+  float tempC() const { return -45.0f + 175.0f * (float)t_raw / 65535.0f; }
+  /** - Relative humidity in % */
+  float rhPercent() const { return 100.0f * (float)rh_raw / 65535.0f; }
+};
+
+#endif  // _7Semi_SCD4X_SAMPLE_H
@@ -0,0 +1,196 @@
+/**
+ * 7Semi_SCD4x_Sdt.cpp
+ * -------------------
+ * Swinging-door trending compressor / decoder
+ *
+ * Implementation Notes
+ * --------------------
+ * - Upper door tracks max((v − v0 − E)/Δt), lower door min((v − v0 + E)/Δt);
+ *   any slope between them keeps every pending sample within ±E of the line.
+ * - Doors "open past parallel" when upper > lower; the previous sample is
+ *   then archived and the doors restart from it through the current sample.
+ * - Work is in doubled units with half-width 2E − 1 (E − ½), leaving ½ LSB
+ *   for rounding the archived value to an integer; E = 0 is lossless.
+ * - Slopes are kept as num/den and compared by cross-multiplication
+ *   (|num| < 2³⁰, den < 2³², product fits int64), so long gaps do not truncate.
+ * - Samples with a repeated timestamp are ignored.
+ */
+
+#include "7Semi_SCD4x_Sdt.h"
+
+/**
+- Construct compressor with error bound E
+*/
+SCD4x_Sdt_7Semi::SCD4x_Sdt_7Semi(int32_t error_bound)
+  : bound(error_bound < 0 ? 0 : error_bound), nextBound(bound) {}
+
+void SCD4x_Sdt_7Semi::setErrorBound(int32_t error_bound) {
+  nextBound = (error_bound < 0) ? 0 : error_bound;
+}
+
+void SCD4x_Sdt_7Semi::reset() {
+  state = 0;
+  bound = nextBound;
+  nIn = 0;
+  nOut = 0;
+}
+
+/**
+- Add one sample; may emit the previous sample as a turning point
+*/
+bool SCD4x_Sdt_7Semi::add(uint32_t t_ms, int32_t value, SCD4x_SdtPoint_7Semi &out) {
+  if (state == 0) {
+    ++nIn;
+    pivotT = t_ms;
+    pivotV = value;
+    bound = nextBound;
+    state = 1;
+    out.t_ms = t_ms;
+    out.value = value;
+    ++nOut;
+    return true;
+  }
+
+  const uint32_t ref = (state == 1) ? pivotT : lastT;
+  if (t_ms == ref) return false;
+  ++nIn;
+
+  if (state == 1) {
+    openDoors(t_ms, value);
+    state = 2;
+    return false;
+  }
+
+  const uint32_t dt = t_ms - pivotT;
+  const int32_t  dv = 2 * (value - pivotV);
+  const int32_t  upN = dv - width();
+  const int32_t  lowN = dv + width();
+  const bool upMoves = greater(upN, dt, upNum, upDen);
+  const bool lowMoves = greater(lowNum, lowDen, lowN, dt);
+
+  // Would the doors open past parallel with this sample?
+  if (!greater(upMoves ? upN : upNum, upMoves ? dt : upDen,
+               lowMoves ? lowN : lowNum, lowMoves ? dt : lowDen)) {
+    if (upMoves) { upNum = upN; upDen = dt; }
+    if (lowMoves) { lowNum = lowN; lowDen = dt; }
+    lastT = t_ms;
+    lastV = value;
+    return false;
+  }
+
+  // Doors opened: archive the previous sample and pivot on it
+  archive(out);
+  openDoors(t_ms, value);
+  return true;
+}
+
+/**
+- Emit pending sample (if any) and make it the new pivot
+*/
+bool SCD4x_Sdt_7Semi::flush(SCD4x_SdtPoint_7Semi &out) {
+  if (state != 2) return false;
+  archive(out);
+  state = 1;
+  return true;
+}
+
+uint32_t SCD4x_Sdt_7Semi::samplesIn() const { return nIn; }
+
+uint32_t SCD4x_Sdt_7Semi::pointsOut() const { return nOut; }
+
+// ================= Decoder =================
+
+/**
+- Value at t_ms by linear interpolation (binary search for the segment)
+- Times are compared as wrapped offsets from pts[0], so a series may cross
+  the millis() rollover
+*/
+int32_t SCD4x_Sdt_7Semi::interpolate(const SCD4x_SdtPoint_7Semi *pts, size_t n, uint32_t t_ms) {
+  if (n == 0) return 0;
+  const uint32_t t0 = pts[0].t_ms;
+  const uint32_t rt = t_ms - t0;
+  const uint32_t rEnd = pts[n - 1].t_ms - t0;
+  if (rt == 0) return pts[0].value;
+  if (rt >= rEnd) {
+    // Outside the series: clamp to the nearer end (before start wraps high)
+    return (rt - rEnd <= (uint32_t)0 - rt) ? pts[n - 1].value : pts[0].value;
+  }
+  size_t lo = 0, hi = n - 1;
+  while (hi - lo > 1) {
+    size_t mid = (lo + hi) / 2;
+    if (pts[mid].t_ms - t0 <= rt) lo = mid;
+    else hi = mid;
+  }
+  return lerp(pts[lo], pts[hi], t_ms);
+}
+
+/**
+- Reconstruct a series of timestamps in one forward pass
+*/
+void SCD4x_Sdt_7Semi::decompress(const SCD4x_SdtPoint_7Semi *pts, size_t n,
+                                 const uint32_t *t_ms, int32_t *out, size_t nout) {
+  size_t j = 0;
+  const uint32_t t0 = n ? pts[0].t_ms : 0;
+  for (size_t i = 0; i < nout; ++i) {
+    const uint32_t t = t_ms[i];
+    if (n == 0) { out[i] = 0; continue; }
+    const uint32_t rt = t - t0;  // wrapped offset from the first point
+    while (j + 1 < n && pts[j + 1].t_ms - t0 <= rt) ++j;
+    if (j + 1 >= n || rt <= pts[j].t_ms - t0) out[i] = pts[j].value;
+    else out[i] = lerp(pts[j], pts[j + 1], t);
+  }
+}
+
+// ================= Helpers =================
+
+int32_t SCD4x_Sdt_7Semi::width() const {
+  return bound ? 2 * bound - 1 : 0;
+}
+
+void SCD4x_Sdt_7Semi::openDoors(uint32_t t, int32_t v) {
+  const int32_t dv = 2 * (v - pivotV);
+  upNum = dv - width();
+  lowNum = dv + width();
+  upDen = lowDen = t - pivotT;
+  lastT = t;
+  lastV = v;
+}
+
+/**
+- Archive pending sample: clamp 2·lastV into [2·v0 + up·Δt, 2·v0 + low·Δt],
+  round to an integer value, and pivot on it
+*/
+void SCD4x_Sdt_7Semi::archive(SCD4x_SdtPoint_7Semi &out) {
+  const int64_t dt = (int64_t)(uint32_t)(lastT - pivotT);
+  int64_t num = 2 * (int64_t)lastV;  // doubled units, over den
+  int64_t den = 1;
+  if (greater(upNum, upDen, 2 * (lastV - pivotV), (uint32_t)dt)) {
+    num = 2 * (int64_t)pivotV * upDen + (int64_t)upNum * dt;
+    den = upDen;
+  } else if (greater(2 * (lastV - pivotV), (uint32_t)dt, lowNum, lowDen)) {
+    num = 2 * (int64_t)pivotV * lowDen + (int64_t)lowNum * dt;
+    den = lowDen;
+  }
+  // value = round(num / (2·den))
+  den *= 2;
+  const int64_t half = (num >= 0) ? den / 2 : -den / 2;
+  const int32_t w = (int32_t)((num + half) / den);
+
+  out.t_ms = lastT;
+  out.value = w;
+  ++nOut;
+  pivotT = lastT;
+  pivotV = w;
+  bound = nextBound;
+}
+
+bool SCD4x_Sdt_7Semi::greater(int32_t a, uint32_t b, int32_t c, uint32_t d) {
+  return (int64_t)a * d > (int64_t)c * b;
+}
+
+int32_t SCD4x_Sdt_7Semi::lerp(const SCD4x_SdtPoint_7Semi &a, const SCD4x_SdtPoint_7Semi &b, uint32_t t) {
+  const int64_t den = (int64_t)(uint32_t)(b.t_ms - a.t_ms);
+  const int64_t num = ((int64_t)b.value - a.value) * (int64_t)(uint32_t)(t - a.t_ms);
+  const int64_t half = (num >= 0) ? den / 2 : -den / 2;
+  return (int32_t)(a.value + (num + half) / den);
+}
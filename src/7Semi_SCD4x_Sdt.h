@@ -0,0 +1,115 @@
+#ifndef _7Semi_SCD4X_SDT_H
+#define _7Semi_SCD4X_SDT_H
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
+
+/**
+ * 7Semi_SCD4x_Sdt.h
+ * -----------------
+ * Swinging-door trending (SDT) compression for one SCD4x channel
+ *
+ * Method
+ * ------
+ * - Two "doors" pivot at (t0, v0 ± E) from the last archived point.
+ * - Each sample narrows the doors; once they open past parallel, the
+ *   previous sample is archived (emitted) and becomes the new pivot.
+ * - The archived value is the previous sample clamped into the door
+ *   corridor, so linear interpolation between archived points reproduces
+ *   every input sample within ±E (strict, including integer rounding).
+ *
+ * Notes
+ * -----
+ * - Fixed memory: ~40 bytes per channel, integer math (exact rational slopes).
+ * - Values are int32 in caller units (ppm, 0.01 °C, 0.01 %RH …), |v| < 2²⁸.
+ * - Timestamps must be strictly increasing (uint32 ms, rollover-safe deltas).
+ *   The decoder measures time from the first archived point, so a series
+ *   may cross the millis() wrap as long as it spans < 2³² ms (~49 days).
+ * - Header builds without Arduino.h, so the decoder runs on the host too.
+ */
+
+/** - One archived (turning) point */
+struct SCD4x_SdtPoint_7Semi {
+  uint32_t t_ms;
+  int32_t  value;
+};
+
+class SCD4x_Sdt_7Semi {
+public:
+  /**
+   * - Construct compressor
+   * - error_bound : maximum reconstruction error E (channel units, ≥ 0)
+   */
+  explicit SCD4x_Sdt_7Semi(int32_t error_bound = 0);
+
+  /** - Set error bound; takes effect from the next archived point */
+  void setErrorBound(int32_t error_bound);
+  /** - Drop state (pending sample is lost; call flush() first to keep it) */
+  void reset();
+
+  /**
+   * - Add one sample
+   * - out    : receives an archived point when one is emitted
+   * - return : true if out was written
+   */
+  bool add(uint32_t t_ms, int32_t value, SCD4x_SdtPoint_7Semi &out);
+  /**
+   * - Emit the last pending sample (end of stream / before sleep)
+   * - return : true if out was written
+   */
+  bool flush(SCD4x_SdtPoint_7Semi &out);
+
+  /** - Samples consumed */
+  uint32_t samplesIn() const;
+  /** - Points emitted */
+  uint32_t pointsOut() const;
+
+  // ---------------------- Decoder ------------------------
+  /**
+   * - Reconstruct value at t_ms from archived points (linear interpolation)
+   * - pts : archived points in time order, n ≥ 1
+   * - Times outside the range clamp to the nearer of the first / last point.
+   */
+  static int32_t interpolate(const SCD4x_SdtPoint_7Semi *pts, size_t n, uint32_t t_ms);
+  /**
+   * - Reconstruct values at the given timestamps (both in time order)
+   * - One forward pass; O(n + nout)
+   * - Timestamps are offsets from pts[0] (wrap-safe); pass times from
+   *   pts[0] on, e.g. the compressed samples' own times
+   */
+  static void decompress(const SCD4x_SdtPoint_7Semi *pts, size_t n,
+                         const uint32_t *t_ms, int32_t *out, size_t nout);
+
+private:
+  int32_t  bound;
+  int32_t  nextBound;
+  uint8_t  state = 0;      // 0 empty, 1 pivot only, 2 pivot + pending
+  uint32_t pivotT = 0;
+  int32_t  pivotV = 0;
+  uint32_t lastT = 0;
+  int32_t  lastV = 0;
+  // Door slopes as num/den (doubled value units per ms, den > 0)
+  int32_t  upNum = 0;      // max slope of upper door
+  uint32_t upDen = 1;
+  int32_t  lowNum = 0;     // min slope of lower door
+  uint32_t lowDen = 1;
+  uint32_t nIn = 0;
+  uint32_t nOut = 0;
+
+  /** - Door half-width in doubled units (2E − 1, or 0 for lossless) */
+  int32_t width() const;
+  /** - Open doors from the current pivot through (t, v) */
+  void openDoors(uint32_t t, int32_t v);
+  /** - Archive the pending sample (clamped into the corridor) as new pivot */
+  void archive(SCD4x_SdtPoint_7Semi &out);
+  /** - a/b > c/d for b, d > 0 */
+  static bool greater(int32_t a, uint32_t b, int32_t c, uint32_t d);
+  /** - Interpolate between two points */
+  static int32_t lerp(const SCD4x_SdtPoint_7Semi &a, const SCD4x_SdtPoint_7Semi &b, uint32_t t);
+};
+
+#endif  // _7Semi_SCD4X_SDT_H
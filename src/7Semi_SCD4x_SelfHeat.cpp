@@ -0,0 +1,158 @@
+/**
+ * 7Semi_SCD4x_SelfHeat.cpp
+ * ------------------------
+ * Mode / duty-cycle self-heating offsets, consistent RH and reference learning
+ *
+ * Implementation Notes
+ * --------------------
+ * - RH is rescaled by the saturation pressure ratio, which keeps the
+ *   absolute humidity (and dew point) of the reading unchanged; the result
+ *   is clamped to 0..100 %.
+ * - The duty filter uses α = Δt / (τ + Δt), stable for any Δt, so sparse
+ *   radio() calls only lose resolution, not accuracy.
+ * - The fit keeps six weighted sums and a count per mode (28 bytes). A
+ *   duty spread below 5 % makes the 2×2 system ill-conditioned, so then
+ *   only the base is solved, with the slope held.
+ */
+
+#include "7Semi_SCD4x_SelfHeat.h"
+#include "7Semi_SCD4x_Psychro.h"
+
+#define SCD4X_SELFHEAT_MIN_SPREAD  0.0025f   // duty variance for a slope fit (5 %²)
+
+// ================= Setup =================
+
+SCD4x_SelfHeat_7Semi::SCD4x_SelfHeat_7Semi() {
+  memset(baseC, 0, sizeof(baseC));
+  memset(slopeC, 0, sizeof(slopeC));
+  memset(fit, 0, sizeof(fit));
+}
+
+void SCD4x_SelfHeat_7Semi::setOffset(Mode mode, int16_t base_centi, int16_t slope_centi) {
+  if (mode >= MODE_COUNT) return;
+  baseC[mode] = base_centi;
+  slopeC[mode] = slope_centi;
+}
+
+bool SCD4x_SelfHeat_7Semi::loadProfile(const SCD4x_Profile_7Semi &p) {
+  if (!(p.flags & SCD4X_PROFILE_SELF_HEAT)) return false;
+  baseC[PERIODIC] = p.selfHeatStd;
+  baseC[LOW_POWER] = p.selfHeatLp;
+  slopeC[PERIODIC] = p.selfHeatSlopeStd;
+  slopeC[LOW_POWER] = p.selfHeatSlopeLp;
+  return true;
+}
+
+void SCD4x_SelfHeat_7Semi::storeProfile(SCD4x_Profile_7Semi &p) const {
+  p.setSelfHeating(baseC[PERIODIC], baseC[LOW_POWER], slopeC[PERIODIC], slopeC[LOW_POWER]);
+}
+
+// ================= Operating point =================
+
+void SCD4x_SelfHeat_7Semi::setMode(Mode mode) {
+  if (mode < MODE_COUNT) cur = mode;
+}
+
+void SCD4x_SelfHeat_7Semi::setDutyCycle(uint16_t permille) {
+  dutyF = (permille > 1000 ? 1000 : permille) / 1000.0f;
+}
+
+void SCD4x_SelfHeat_7Semi::setThermalTau(uint32_t ms) { tauMs = ms; }
+
+/**
+- First-order lag towards 1 (on) or 0 (off) over the interval just ended
+*/
+void SCD4x_SelfHeat_7Semi::radio(bool on, uint32_t now_ms) {
+  if (haveRadio) {
+    const float dt = (float)(uint32_t)(now_ms - lastRadioMs);
+    const float a = dt / ((float)tauMs + dt);
+    dutyF += ((radioOn ? 1.0f : 0.0f) - dutyF) * a;
+  }
+  haveRadio = true;
+  radioOn = on;
+  lastRadioMs = now_ms;
+}
+
+int16_t SCD4x_SelfHeat_7Semi::offsetCenti() const {
+  const float o = (float)baseC[cur] + (float)slopeC[cur] * dutyF;
+  return (int16_t)(o < 0 ? o - 0.5f : o + 0.5f);
+}
+
+// ================= Correction =================
+
+/**
+- T' = T − offset; RH' = RH · es(T) / es(T')
+*/
+void SCD4x_SelfHeat_7Semi::correct(float &t_c, float &rh) const {
+  const int16_t o = offsetCenti();
+  if (!o) return;
+  const float t2 = t_c - (float)o * 0.01f;
+  const float es2 = SCD4x_Psychro_7Semi::saturationPressure(t2);
+  if (es2 > 0.0f) {
+    rh *= SCD4x_Psychro_7Semi::saturationPressure(t_c) / es2;
+    if (rh > 100.0f) rh = 100.0f;
+    if (rh < 0.0f) rh = 0.0f;
+  }
+  t_c = t2;
+}
+
+void SCD4x_SelfHeat_7Semi::correctFixed(int16_t &t_c, uint16_t &rh_c) const {
+  const int16_t o = offsetCenti();
+  if (!o) return;
+  const int16_t t2 = (int16_t)(t_c - o);
+  const uint32_t es1 = SCD4x_Psychro_7Semi::saturationPressureFixed(t_c);
+  const uint32_t es2 = SCD4x_Psychro_7Semi::saturationPressureFixed(t2);
+  if (es2) {
+    const uint64_t v = ((uint64_t)rh_c * es1 + es2 / 2) / es2;
+    rh_c = v > 10000 ? 10000 : (uint16_t)v;
+  }
+  t_c = t2;
+}
+
+// ================= Learning =================
+
+void SCD4x_SelfHeat_7Semi::setLearning(uint16_t min_samples, float forget) {
+  minSamples = min_samples;
+  forgetF = forget;
+}
+
+void SCD4x_SelfHeat_7Semi::resetLearning() { memset(fit, 0, sizeof(fit)); }
+
+/**
+- Weighted least squares of (T − T_ref) against duty, per mode
+*/
+bool SCD4x_SelfHeat_7Semi::learn(float t_measured, float t_reference) {
+  Fit &f = fit[cur];
+  const float r = t_measured - t_reference;
+  const float d = dutyF;
+  f.w = f.w * forgetF + 1.0f;
+  f.d = f.d * forgetF + d;
+  f.dd = f.dd * forgetF + d * d;
+  f.r = f.r * forgetF + r;
+  f.dr = f.dr * forgetF + d * r;
+  f.rr = f.rr * forgetF + r * r;
+  ++f.n;
+  if (f.n < minSamples) return false;
+
+  float s = (float)slopeC[cur] * 0.01f;
+  const float var = f.w * f.dd - f.d * f.d;
+  if (var > SCD4X_SELFHEAT_MIN_SPREAD * f.w * f.w) s = (f.w * f.dr - f.d * f.r) / var;
+  const float b = (f.r - s * f.d) / f.w;
+
+  const float bc = b * 100.0f, sc = s * 100.0f;
+  if (bc < -32768.0f || bc > 32767.0f || sc < -32768.0f || sc > 32767.0f) return false;
+  baseC[cur] = (int16_t)(bc < 0 ? bc - 0.5f : bc + 0.5f);
+  slopeC[cur] = (int16_t)(sc < 0 ? sc - 0.5f : sc + 0.5f);
+  return true;
+}
+
+/**
+- Residual Σw(r − b − s·d)² expanded over the stored sums
+*/
+float SCD4x_SelfHeat_7Semi::learnRms(Mode mode) const {
+  if (mode >= MODE_COUNT || fit[mode].w <= 0.0f) return 0.0f;
+  const Fit &f = fit[mode];
+  const float b = baseC[mode] * 0.01f, s = slopeC[mode] * 0.01f;
+  const float e = f.rr - 2.0f * b * f.r - 2.0f * s * f.dr + b * b * f.w + 2.0f * b * s * f.d + s * s * f.dd;
+  return e > 0.0f ? sqrtf(e / f.w) : 0.0f;
+}
@@ -0,0 +1,126 @@
+#ifndef _7Semi_SCD4X_SELFHEAT_H
+#define _7Semi_SCD4X_SELFHEAT_H
+
+#include <Arduino.h>
+#include "7Semi_SCD4x_Profile.h"
+
+/**
+ * 7Semi_SCD4x_SelfHeat.h
+ * ----------------------
+ * Software self-heating correction for SCD4x T / RH, adjustable while
+ * measuring (no stop / restart for setTemperatureOffset())
+ *
+ * Model
+ * -----
+ *   offset = base[mode] + slope[mode] · duty        (0.01 °C, duty 0..1)
+ *   T'     = T − offset
+ *   RH'    = RH · es(T) / es(T')                    (same water vapour)
+ * - mode : PERIODIC, or LOW_POWER for low-power periodic and single-shot
+ *          (less electronics on, less heat).
+ * - duty : radio / load duty cycle, either set directly or filtered from
+ *          radio() on/off events through a first-order thermal lag
+ *          (default τ = 5 min), since the board heats up and cools down
+ *          slowly.
+ * - es(T) is SCD4x_Psychro_7Semi's table (no expf).
+ *
+ * Learning
+ * --------
+ * - learn(T, T_ref) fits base and slope for the current mode from
+ *   readMeasurement() T and a co-located reference thermometer. The fit
+ *   is a weighted least squares with exponential forgetting, so the
+ *   offsets follow slow changes in enclosure or airflow.
+ * - The slope is only refitted once the duty seen covers ≥ 5 % spread;
+ *   until then only the base moves. New coefficients take effect after
+ *   minSamples readings and never touch the sensor.
+ *
+ * Notes
+ * -----
+ * - The on-sensor temperature offset (profile, default 4 °C) still
+ *   applies; this layer corrects what varies around it.
+ * - Coefficients map to the profile store: loadProfile() / storeProfile()
+ *   carry the bases (selfHeatStd / selfHeatLp) and the duty slopes
+ *   (selfHeatSlopeStd / selfHeatSlopeLp).
+ */
+
+class SCD4x_SelfHeat_7Semi {
+public:
+  enum Mode : uint8_t { PERIODIC = 0, LOW_POWER, MODE_COUNT };
+
+  SCD4x_SelfHeat_7Semi();
+
+  // --------------------- Coefficients ---------------------
+  /**
+   * - Offsets for one mode
+   * - base_centi  : self-heating at zero duty (0.01 °C, positive = too warm)
+   * - slope_centi : additional heating at 100 % duty (0.01 °C)
+   */
+  void setOffset(Mode mode, int16_t base_centi, int16_t slope_centi = 0);
+  int16_t base(Mode mode) const { return baseC[mode]; }
+  int16_t slope(Mode mode) const { return slopeC[mode]; }
+  /** - Take bases and slopes from a profile; false if it has no self-heating */
+  bool loadProfile(const SCD4x_Profile_7Semi &p);
+  /** - Write bases and slopes into a profile (then SCD4x_ProfileStore_7Semi::save()) */
+  void storeProfile(SCD4x_Profile_7Semi &p) const;
+
+  // -------------------- Operating point -------------------
+  void setMode(Mode mode);
+  Mode mode() const { return (Mode)cur; }
+  /** - Duty cycle in ‰, used as is (bypasses the thermal filter) */
+  void setDutyCycle(uint16_t permille);
+  /** - Thermal time constant of the duty filter (ms) */
+  void setThermalTau(uint32_t ms);
+  /**
+   * - Radio (or other load) state; call on every change and at least
+   *   once per sample so the filter advances
+   */
+  void radio(bool on, uint32_t now_ms);
+  /** - Effective duty cycle in ‰ */
+  uint16_t duty() const { return (uint16_t)(dutyF * 1000.0f + 0.5f); }
+  /** - Offset in force (0.01 °C) */
+  int16_t offsetCenti() const;
+
+  // ---------------------- Correction ----------------------
+  /** - Correct readMeasurement() output in place (°C, %RH) */
+  void correct(float &t_c, float &rh) const;
+  /** - Integer form: t_c in 0.01 °C, rh_c in 0.01 %RH */
+  void correctFixed(int16_t &t_c, uint16_t &rh_c) const;
+
+  // ----------------------- Learning -----------------------
+  /**
+   * - min_samples : readings before learned offsets are applied
+   * - forget      : weight kept per reading (0.995 ≈ 200-reading memory)
+   */
+  void setLearning(uint16_t min_samples, float forget = 0.995f);
+  /**
+   * - Feed one uncorrected reading and the reference temperature (°C)
+   * - return : true if the current mode's coefficients were updated
+   */
+  bool learn(float t_measured, float t_reference);
+  /** - Readings learned for mode */
+  uint32_t learnCount(Mode mode) const { return fit[mode].n; }
+  /** - RMS residual of the fit for mode (°C) */
+  float learnRms(Mode mode) const;
+  void resetLearning();
+
+private:
+  struct Fit {
+    uint32_t n;
+    float w, d, dd, r, dr, rr;   // Σw, Σw·d, Σw·d², Σw·r, Σw·d·r, Σw·r²
+  };
+
+  int16_t baseC[MODE_COUNT];
+  int16_t slopeC[MODE_COUNT];
+  uint8_t cur = PERIODIC;
+
+  float dutyF = 0.0f;            // 0..1
+  bool radioOn = false;
+  bool haveRadio = false;
+  uint32_t lastRadioMs = 0;
+  uint32_t tauMs = 300000;
+
+  Fit fit[MODE_COUNT];
+  uint16_t minSamples = 12;
+  float forgetF = 0.995f;
+};
+
+#endif  // _7Semi_SCD4X_SELFHEAT_H
@@ -0,0 +1,155 @@
+/**
+ * 7Semi_SCD4x_Serializer.cpp
+ * --------------------------
+ * Integer-only JSON / CSV formatting straight into a Print
+ *
+ * Implementation Notes
+ * --------------------
+ * - Longest record: JSON with 10-digit t, 5-digit CO₂, "-45.00", "100.00"
+ *   → 52 chars + "\r\n"; the 64-byte buffer leaves headroom.
+ * - Decimal conversion writes digits backwards into a 10-byte scratch area.
+ */
+
+#include "7Semi_SCD4x_Serializer.h"
+
+static const uint8_t RECORD_MAX = 64;
+
+/**
+- Bind to output and format
+*/
+SCD4x_Serializer_7Semi::SCD4x_Serializer_7Semi(Print &o, Format f) : out(o), fmt(f) {}
+
+void SCD4x_Serializer_7Semi::setFormat(Format f) { fmt = f; }
+
+/**
+- CSV header line
+*/
+size_t SCD4x_Serializer_7Semi::writeHeader() {
+  if (fmt != CSV) return 0;
+  static const char hdr[] = "t_ms,co2_ppm,temp_c,rh_pct\r\n";
+  return emit(hdr, sizeof(hdr) - 1, micros());
+}
+
+/**
+- One raw sample as a record
+*/
+size_t SCD4x_Serializer_7Semi::write(const SCD4x_RawSample_7Semi &s) {
+  const uint32_t t0 = micros();
+  char buf[RECORD_MAX];
+  size_t n = format(buf, s.t_ms, s.co2_raw, s.tempCentiC(), s.rhCenti());
+  buf[n++] = '\r';
+  buf[n++] = '\n';
+  return emit(buf, n, t0);
+}
+
+/**
+- One decoded sample as a record
+*/
+size_t SCD4x_Serializer_7Semi::write(uint32_t t_ms, uint16_t co2_ppm, float temp_c, float rh_percent) {
+  const uint32_t t0 = micros();
+  const int16_t t = (int16_t)(temp_c * 100.0f + (temp_c >= 0.0f ? 0.5f : -0.5f));
+  const uint16_t rh = (uint16_t)(rh_percent * 100.0f + 0.5f);
+  char buf[RECORD_MAX];
+  size_t n = format(buf, t_ms, co2_ppm, t, rh);
+  buf[n++] = '\r';
+  buf[n++] = '\n';
+  return emit(buf, n, t0);
+}
+
+/**
+- Batch of raw samples (JSON array or CSV rows)
+*/
+size_t SCD4x_Serializer_7Semi::writeBatch(const SCD4x_RawSample_7Semi *s, size_t n) {
+  if (fmt == CSV) {
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i) total += write(s[i]);
+    return total;
+  }
+
+  const uint32_t t0 = micros();
+  size_t total = emit("[", 1, t0);
+  for (size_t i = 0; i < n; ++i) {
+    const uint32_t t1 = micros();
+    char buf[RECORD_MAX];
+    size_t len = format(buf, s[i].t_ms, s[i].co2_raw, s[i].tempCentiC(), s[i].rhCenti());
+    if (i + 1 < n) buf[len++] = ',';
+    total += emit(buf, len, t1);
+  }
+  return total + emit("]\r\n", 3, micros());
+}
+
+// ================= Stats =================
+
+uint32_t SCD4x_Serializer_7Semi::bytesWritten() const { return nBytes; }
+
+uint32_t SCD4x_Serializer_7Semi::microsSpent() const { return nMicros; }
+
+uint32_t SCD4x_Serializer_7Semi::bytesPerMs() const {
+  return nMicros ? (uint32_t)((uint64_t)nBytes * 1000 / nMicros) : 0;
+}
+
+void SCD4x_Serializer_7Semi::resetStats() {
+  nBytes = 0;
+  nMicros = 0;
+}
+
+// ================= Helpers =================
+
+/**
+- Build one record without line terminator
+*/
+size_t SCD4x_Serializer_7Semi::format(char *buf, uint32_t t_ms, uint16_t co2, int16_t t_c, uint16_t rh_c) const {
+  char *p = buf;
+  if (fmt == JSON) {
+    memcpy(p, "{\"t\":", 5);        p += 5;
+    p += putU32(p, t_ms);
+    memcpy(p, ",\"co2\":", 7);      p += 7;
+    p += putU32(p, co2);
+    memcpy(p, ",\"temp\":", 8);     p += 8;
+    p += putCenti(p, t_c);
+    memcpy(p, ",\"rh\":", 6);       p += 6;
+    p += putCenti(p, rh_c);
+    *p++ = '}';
+  } else {
+    p += putU32(p, t_ms);
+    *p++ = ',';
+    p += putU32(p, co2);
+    *p++ = ',';
+    p += putCenti(p, t_c);
+    *p++ = ',';
+    p += putCenti(p, rh_c);
+  }
+  return (size_t)(p - buf);
+}
+
+size_t SCD4x_Serializer_7Semi::emit(const char *buf, size_t len, uint32_t t0) {
+  size_t n = out.write((const uint8_t *)buf, len);
+  nBytes += n;
+  nMicros += micros() - t0;
+  return n;
+}
+
+size_t SCD4x_Serializer_7Semi::putU32(char *p, uint32_t v) {
+  char tmp[10];
+  size_t n = 0;
+  do {
+    tmp[n++] = (char)('0' + v % 10);
+    v /= 10;
+  } while (v);
+  for (size_t i = 0; i < n; ++i) p[i] = tmp[n - 1 - i];
+  return n;
+}
+
+size_t SCD4x_Serializer_7Semi::putCenti(char *p, int32_t v) {
+  size_t n = 0;
+  if (v < 0) {
+    p[n++] = '-';
+    v = -v;
+  }
+  n += putU32(p + n, (uint32_t)v / 100);
+  const uint8_t frac = (uint8_t)((uint32_t)v % 100);
+  p[n++] = '.';
+  p[n++] = (char)('0' + frac / 10);
+  p[n++] = (char)('0' + frac % 10);
+  return n;
+}
@@ -0,0 +1,79 @@
+#ifndef _7Semi_SCD4X_SERIALIZER_H
+#define _7Semi_SCD4X_SERIALIZER_H
+
+#include <Arduino.h>
+#include "7Semi_SCD4x_Sample.h"
+
+/**
+ * 7Semi_SCD4x_Serializer.h
+ * ------------------------
+ * Allocation-free JSON / CSV output of SCD4x samples to any Print
+ *
+ * Output
+ * ------
+ * - JSON : {"t":123456,"co2":612,"temp":22.43,"rh":41.25}
+ *          batches as [ {...},{...} ] on one line
+ * - CSV  : t_ms,co2_ppm,temp_c,rh_pct  (header) / 123456,612,22.43,41.25
+ * - Each record ends with "\r\n" (same as Print::println()).
+ *
+ * Notes
+ * -----
+ * - Values are formatted from integers (0.01 °C / 0.01 %RH), never through
+ *   the float printer; no String, no heap.
+ * - One record is built in a 64-byte stack buffer and sent with a single
+ *   Print::write(buf, len), instead of one call per field.
+ * - Bytes written and µs spent are accumulated for throughput checks.
+ */
+
+class SCD4x_Serializer_7Semi {
+public:
+  enum Format : uint8_t { JSON = 0, CSV = 1 };
+
+  /**
+   * - Bind serializer to an output
+   * - out : Serial, a file, a network client …
+   * - fmt : JSON or CSV
+   */
+  SCD4x_Serializer_7Semi(Print &out, Format fmt = JSON);
+
+  /** - Change output format */
+  void setFormat(Format fmt);
+  /** - CSV: write column header; JSON: no-op. Returns bytes written */
+  size_t writeHeader();
+  /** - Write one raw sample. Returns bytes written */
+  size_t write(const SCD4x_RawSample_7Semi &s);
+  /**
+   * - Write one decoded sample (as returned by readMeasurement())
+   * - Floats are rounded to 0.01 before formatting (no float printing)
+   */
+  size_t write(uint32_t t_ms, uint16_t co2_ppm, float temp_c, float rh_percent);
+  /** - Write n samples (JSON: one array). Returns bytes written */
+  size_t writeBatch(const SCD4x_RawSample_7Semi *s, size_t n);
+
+  // ----------------------- Stats -------------------------
+  /** - Total bytes written */
+  uint32_t bytesWritten() const;
+  /** - Total µs spent formatting + writing */
+  uint32_t microsSpent() const;
+  /** - Throughput in bytes per ms (= bytes/µs × 1000) */
+  uint32_t bytesPerMs() const;
+  /** - Clear counters */
+  void resetStats();
+
+private:
+  Print   &out;
+  Format   fmt;
+  uint32_t nBytes = 0;
+  uint32_t nMicros = 0;
+
+  /** - Format one record into buf (no terminator), return length */
+  size_t format(char *buf, uint32_t t_ms, uint16_t co2, int16_t t_c, uint16_t rh_c) const;
+  /** - Send buf and update stats */
+  size_t emit(const char *buf, size_t len, uint32_t t0);
+  /** - Append unsigned decimal */
+  static size_t putU32(char *p, uint32_t v);
+  /** - Append signed fixed-point value with 2 decimals */
+  static size_t putCenti(char *p, int32_t v);
+};
+
+#endif  // _7Semi_SCD4X_SERIALIZER_H